@@ -0,0 +1,102 @@
+#ifndef MYTINYSTL_ALIGNED_ALLOCATOR_H_
+#define MYTINYSTL_ALIGNED_ALLOCATOR_H_
+
+// 这个头文件包含模板类 aligned_allocator 和 cache_padded
+// aligned_allocator<T, Align> : 起始地址按 Align 对齐，并把缓冲区大小补齐到 Align 的倍数，
+//                               缓冲区的首尾都不会与其他分配共享缓存行
+// cache_padded<T>             : 独占一个缓存行的包装，用于每个线程一个槽位的数组，避免伪共享
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+#include "exceptdef.h"
+#include "util.h"
+
+namespace mystl
+{
+    // 缓存行大小
+    constexpr size_t cache_line_size = 64;
+
+    template <class T, size_t Align = cache_line_size>
+    class aligned_allocator
+    {
+    public:
+        // 实际使用的对齐：不小于 T 自身的对齐要求
+        static constexpr size_t alignment = Align < alignof(T) ? alignof(T) : Align;
+        static_assert((Align & (Align - 1)) == 0, "Align must be a power of two");
+
+        typedef T value_type;
+        typedef T *pointer;
+        typedef const T *const_pointer;
+        typedef T &reference;
+        typedef const T &const_reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        template <class U>
+        struct rebind
+        {
+            typedef aligned_allocator<U, Align> other;
+        };
+
+        // 没有状态
+        typedef std::true_type propagate_on_container_move_assignment;
+        typedef std::true_type is_always_equal;
+
+    public:
+        aligned_allocator() noexcept = default;
+        template <class U>
+        aligned_allocator(const aligned_allocator<U, Align> &) noexcept {}
+
+        static pointer allocate(size_type n)
+        {
+            THROW_LENGTH_ERROR_IF(n > (static_cast<size_type>(-1) - alignment) / sizeof(T),
+                                  "aligned_allocator<T>::allocate(n) too big");
+            return static_cast<pointer>(::operator new(padded_size(n), std::align_val_t(alignment)));
+        }
+        static void deallocate(pointer ptr, size_type n)
+        {
+            if (ptr == nullptr)
+                return;
+            ::operator delete(ptr, padded_size(n), std::align_val_t(alignment));
+        }
+
+    private:
+        // n 个对象的字节数上调至 alignment 的倍数
+        static size_type padded_size(size_type n) noexcept
+        {
+            return (n * sizeof(T) + alignment - 1) & ~(alignment - 1);
+        }
+    };
+
+    template <class T, class U, size_t Align>
+    bool operator==(const aligned_allocator<T, Align> &, const aligned_allocator<U, Align> &) noexcept
+    {
+        return true;
+    }
+    template <class T, class U, size_t Align>
+    bool operator!=(const aligned_allocator<T, Align> &, const aligned_allocator<U, Align> &) noexcept
+    {
+        return false;
+    }
+
+    // --------------------------------------------------------------------------------------
+    // 模板类：cache_padded
+    // 对齐并填充到缓存行大小，数组中相邻的元素不会落在同一个缓存行上
+    template <class T, size_t Align = cache_line_size>
+    struct alignas(Align) cache_padded
+    {
+        T value;
+
+        cache_padded() = default;
+        template <class... Args>
+        explicit cache_padded(Args &&...args) : value(mystl::forward<Args>(args)...) {}
+
+        T &operator*() noexcept { return value; }
+        const T &operator*() const noexcept { return value; }
+        T *operator->() noexcept { return &value; }
+        const T *operator->() const noexcept { return &value; }
+    };
+} // namespace mystl
+#endif // !MYTINYSTL_ALIGNED_ALLOCATOR_H_
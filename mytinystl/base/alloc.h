@@ -0,0 +1,244 @@
+#ifndef MYTINYSTL_ALLOC_H_
+#define MYTINYSTL_ALLOC_H_
+
+// 这个头文件包含一个类 pool_alloc，即 SGI STL 中的二级空间配置器
+// 参考《STL源码剖析》第2章：
+// 小于等于 128 字节的请求按 8 字节上调后，由 16 个 free list 管理，free list 为空时从内存池批量切块补充
+// 大于 128 字节的请求直接交给 ::operator new / ::operator delete，释放时使用带大小的版本
+// 内存池向系统申请的内存不会归还，只会在 free list 之间复用
+
+#include <new>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+namespace mystl
+{
+    // 共用体：free list 的结点
+    // 空闲时存放下一个结点的地址，被分配出去后整块都是用户数据
+    union free_list_node
+    {
+        union free_list_node *next;
+        char data[1];
+    };
+
+    class pool_alloc
+    {
+    public:
+        static constexpr size_t align = 8;                          // 小区块的上调边界
+        static constexpr size_t max_bytes = 128;                    // 小区块的上限
+        static constexpr size_t free_list_count = max_bytes / align; // free list 的个数
+        static constexpr size_t refill_objs = 20;                   // 每次补充的区块个数
+
+    private:
+        inline static free_list_node *free_list_[free_list_count] = {};
+        inline static char *start_free_ = nullptr; // 内存池起始位置
+        inline static char *end_free_ = nullptr;   // 内存池结束位置
+        inline static size_t heap_size_ = 0;       // 已向系统申请的内存总量
+        inline static std::mutex mutex_;
+
+    public:
+        static void *allocate(size_t n);
+        static void deallocate(void *ptr, size_t n);
+        static void *reallocate(void *ptr, size_t old_size, size_t new_size);
+
+        // 批量接口，供线程缓存等前端使用，一次加锁搬运一串区块
+        static free_list_node *allocate_batch(size_t n, size_t &nobjs);
+        static void deallocate_batch(free_list_node *first, free_list_node *last, size_t n);
+
+        // 将 bytes 上调至 align 的倍数
+        static constexpr size_t round_up(size_t bytes) noexcept
+        {
+            return (bytes + align - 1) & ~(align - 1);
+        }
+        // 根据区块大小选择第 n 个 free list，0 字节按最小区块处理
+        static constexpr size_t free_list_index(size_t bytes) noexcept
+        {
+            return bytes == 0 ? 0 : (bytes + align - 1) / align - 1;
+        }
+
+    private:
+        static void *refill(size_t n);
+        static char *chunk_alloc(size_t size, size_t &nobjs);
+    };
+
+    // 分配大小为 n 的空间
+    inline void *pool_alloc::allocate(size_t n)
+    {
+        if (n > max_bytes)
+            return ::operator new(n);
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_list_node *&my_free_list = free_list_[free_list_index(n)];
+        free_list_node *result = my_free_list;
+        if (result == nullptr)
+            return refill(round_up(n == 0 ? 1 : n));
+        my_free_list = result->next;
+        return result;
+    }
+
+    // 释放 ptr 指向的大小为 n 的空间，n 必须与分配时的大小一致
+    inline void pool_alloc::deallocate(void *ptr, size_t n)
+    {
+        if (ptr == nullptr)
+            return;
+        if (n > max_bytes)
+        {
+            ::operator delete(ptr, n);
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_list_node *&my_free_list = free_list_[free_list_index(n)];
+        free_list_node *q = static_cast<free_list_node *>(ptr);
+        q->next = my_free_list;
+        my_free_list = q;
+    }
+
+    // 重新分配空间，同一个 free list 内的大小变化无需搬移
+    inline void *pool_alloc::reallocate(void *ptr, size_t old_size, size_t new_size)
+    {
+        if (old_size > max_bytes && new_size > max_bytes)
+        {
+            void *result = ::operator new(new_size);
+            std::memcpy(result, ptr, old_size < new_size ? old_size : new_size);
+            ::operator delete(ptr, old_size);
+            return result;
+        }
+        if (old_size <= max_bytes && new_size <= max_bytes &&
+            free_list_index(old_size) == free_list_index(new_size))
+            return ptr;
+        void *result = allocate(new_size);
+        std::memcpy(result, ptr, old_size < new_size ? old_size : new_size);
+        deallocate(ptr, old_size);
+        return result;
+    }
+
+    // 批量取出 nobjs 个大小为 n 的区块，串成以 nullptr 结尾的单链表返回
+    // n 不能超过 max_bytes，nobjs 返回实际取出的个数，至少为 1
+    inline free_list_node *pool_alloc::allocate_batch(size_t n, size_t &nobjs)
+    {
+        const size_t size = round_up(n == 0 ? 1 : n);
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_list_node *&my_free_list = free_list_[free_list_index(size)];
+        free_list_node *head = nullptr;
+        size_t got = 0;
+        // 先从 free list 上摘取
+        while (got < nobjs && my_free_list != nullptr)
+        {
+            free_list_node *p = my_free_list;
+            my_free_list = p->next;
+            p->next = head;
+            head = p;
+            ++got;
+        }
+        // 不够的部分直接从内存池切块
+        if (got < nobjs)
+        {
+            size_t rest = nobjs - got;
+            char *chunk = chunk_alloc(size, rest);
+            for (size_t i = 0; i < rest; ++i)
+            {
+                free_list_node *p = reinterpret_cast<free_list_node *>(chunk + size * i);
+                p->next = head;
+                head = p;
+            }
+            got += rest;
+        }
+        nobjs = got;
+        return head;
+    }
+
+    // 把[first, last]这一串大小为 n 的区块一次性归还到 free list
+    inline void pool_alloc::deallocate_batch(free_list_node *first, free_list_node *last, size_t n)
+    {
+        if (first == nullptr)
+            return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_list_node *&my_free_list = free_list_[free_list_index(n)];
+        last->next = my_free_list;
+        my_free_list = first;
+    }
+
+    // 重新填充 free list，返回一个大小为 n 的区块，其余区块挂到 free list 上
+    // 调用者需持有 mutex_
+    inline void *pool_alloc::refill(size_t n)
+    {
+        size_t nobjs = refill_objs;
+        char *chunk = chunk_alloc(n, nobjs);
+        if (nobjs == 1)
+            return chunk;
+        free_list_node *&my_free_list = free_list_[free_list_index(n)];
+        free_list_node *result = reinterpret_cast<free_list_node *>(chunk);
+        free_list_node *cur = reinterpret_cast<free_list_node *>(chunk + n);
+        my_free_list = cur;
+        for (size_t i = 2; i < nobjs; ++i)
+        {
+            free_list_node *next = reinterpret_cast<free_list_node *>(chunk + n * i);
+            cur->next = next;
+            cur = next;
+        }
+        cur->next = nullptr;
+        return result;
+    }
+
+    // 从内存池中取空间给 free list 使用，条件不允许时修改 nobjs
+    // 调用者需持有 mutex_
+    inline char *pool_alloc::chunk_alloc(size_t size, size_t &nobjs)
+    {
+        char *result;
+        size_t need_bytes = size * nobjs;
+        size_t pool_bytes = static_cast<size_t>(end_free_ - start_free_);
+
+        // 如果内存池剩余大小完全满足需求量，返回它
+        if (pool_bytes >= need_bytes)
+        {
+            result = start_free_;
+            start_free_ += need_bytes;
+            return result;
+        }
+
+        // 如果内存池剩余大小不能完全满足需求量，但至少可以分配一个或一个以上的区块，就返回它
+        if (pool_bytes >= size)
+        {
+            nobjs = pool_bytes / size;
+            need_bytes = size * nobjs;
+            result = start_free_;
+            start_free_ += need_bytes;
+            return result;
+        }
+
+        // 如果内存池剩余大小连一个区块都无法满足
+        // 先把残余的零头挂到合适的 free list 上，零头一定是 align 的倍数
+        if (pool_bytes > 0)
+        {
+            free_list_node *&my_free_list = free_list_[free_list_index(pool_bytes)];
+            free_list_node *q = reinterpret_cast<free_list_node *>(start_free_);
+            q->next = my_free_list;
+            my_free_list = q;
+        }
+        const size_t bytes_to_get = (need_bytes << 1) + round_up(heap_size_ >> 4);
+        start_free_ = static_cast<char *>(std::malloc(bytes_to_get));
+        if (start_free_ == nullptr)
+        {
+            // 系统内存不足，试着从更大区块的 free list 中借一块来用
+            for (size_t i = size; i <= max_bytes; i += align)
+            {
+                free_list_node *&my_free_list = free_list_[free_list_index(i)];
+                free_list_node *p = my_free_list;
+                if (p != nullptr)
+                {
+                    my_free_list = p->next;
+                    start_free_ = reinterpret_cast<char *>(p);
+                    end_free_ = start_free_ + i;
+                    return chunk_alloc(size, nobjs);
+                }
+            }
+            end_free_ = nullptr;
+            throw std::bad_alloc();
+        }
+        end_free_ = start_free_ + bytes_to_get;
+        heap_size_ += bytes_to_get;
+        return chunk_alloc(size, nobjs);
+    }
+} // namespace mystl
+#endif // !MYTINYSTL_ALLOC_H_
@@ -0,0 +1,220 @@
+#ifndef MYTINYSTL_ALLOC_TRACE_H_
+#define MYTINYSTL_ALLOC_TRACE_H_
+
+// 这个头文件包含分配轨迹的记录器 alloc_trace
+// 定义宏 MYSTL_ALLOC_TRACE 后，allocator<T> 的每次 allocate / deallocate 都会在 alloc_trace
+// 开始记录之后写入一条 24 字节的二进制记录：时间戳、地址、字节数、类型编号、操作、线程编号
+// 类型第一次出现时先写入一条类型定义记录，后面跟着类型名
+// 轨迹文件可以交给 tools/alloc_replay.cpp 回放，用来离线比较不同的配置器
+//
+//   mystl::alloc_trace::start("app.trace");
+//   ... 运行程序 ...
+//   mystl::alloc_trace::stop();
+//
+// 文件格式：8 字节魔数 "MYSTLTR1"，之后是若干条 alloc_trace_record
+//   op == allocate / deallocate : 一次分配或释放
+//   op == define_type           : size 为类型名长度，type 为编号，之后紧跟类型名，补齐到 8 字节
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <typeinfo>
+#include <vector>
+
+namespace mystl
+{
+    struct alloc_trace_record
+    {
+        enum op_type : uint8_t
+        {
+            allocate = 0,
+            deallocate = 1,
+            define_type = 2
+        };
+
+        uint64_t timestamp; // 自 start() 起的纳秒数
+        uint64_t address;   // 区块地址，回放时用来匹配分配与释放
+        uint32_t size;      // 字节数
+        uint16_t type;      // 类型编号
+        uint8_t op;         // op_type
+        uint8_t thread;     // 线程编号（取低 8 位）
+    };
+    static_assert(sizeof(alloc_trace_record) == 24, "alloc_trace_record must be 24 bytes");
+
+    class alloc_trace
+    {
+    public:
+        static constexpr char magic[8] = {'M', 'Y', 'S', 'T', 'L', 'T', 'R', '1'};
+        static constexpr size_t buffer_records = 4096; // 每个线程缓冲的记录条数
+
+    private:
+        // 线程私有的缓冲区，满了、stop() 或线程退出时写入文件
+        // 所有缓冲区登记在 buffers_ 中，stop() 逐个写入；lock 只在 stop() 时才会有竞争
+        // 加锁顺序：registry_mutex_ -> thread_buffer::lock -> mutex_
+        struct thread_buffer
+        {
+            alloc_trace_record records[buffer_records];
+            size_t count = 0;
+            uint8_t thread = 0;
+            std::mutex lock;
+
+            thread_buffer();
+            ~thread_buffer();
+            void flush(); // 调用者需持有 lock
+        };
+
+        inline static std::atomic<bool> active_{false};
+        inline static std::atomic<unsigned> next_thread_{0};
+        inline static std::FILE *file_ = nullptr;
+        inline static std::mutex mutex_;          // 保护 file_ 与 type_names_
+        inline static std::mutex registry_mutex_; // 保护 buffers_
+        inline static std::vector<thread_buffer *> buffers_;
+        inline static std::atomic<int64_t> start_ns_{0}; // start() 时 steady_clock 的纳秒数
+        inline static std::vector<const char *> type_names_; // 已编号的类型名，下标即编号
+
+    public:
+        // 开始记录，返回文件能否打开
+        static bool start(const char *path)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (file_ != nullptr)
+                return false;
+            file_ = std::fopen(path, "wb");
+            if (file_ == nullptr)
+                return false;
+            std::fwrite(magic, 1, sizeof(magic), file_);
+            // 开始记录之前就已编号的类型，先补写它们的定义
+            for (size_t i = 0; i < type_names_.size(); ++i)
+                write_type(static_cast<uint16_t>(i), type_names_[i]);
+            start_ns_.store(now_ns(), std::memory_order_relaxed);
+            active_.store(true, std::memory_order_release);
+            return true;
+        }
+        // 停止记录，所有线程的缓冲区立即写入文件；
+        // record() 在缓冲区的锁内检查 active_，stop() 之后不会再有记录留在缓冲区里带到下一次 start()
+        static void stop()
+        {
+            active_.store(false, std::memory_order_release);
+            {
+                std::lock_guard<std::mutex> registry(registry_mutex_);
+                for (thread_buffer *buf : buffers_)
+                {
+                    std::lock_guard<std::mutex> lock(buf->lock);
+                    buf->flush();
+                }
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (file_ != nullptr)
+            {
+                std::fclose(file_);
+                file_ = nullptr;
+            }
+        }
+        static bool active() noexcept { return active_.load(std::memory_order_relaxed); }
+
+        static void record(alloc_trace_record::op_type op, const void *ptr, size_t bytes, uint16_t type)
+        {
+            if (!active())
+                return;
+            thread_buffer &buf = local();
+            std::lock_guard<std::mutex> lock(buf.lock);
+            if (!active_.load(std::memory_order_acquire))
+                return;
+            if (buf.count == buffer_records)
+                buf.flush();
+            alloc_trace_record &r = buf.records[buf.count++];
+            r.timestamp = static_cast<uint64_t>(now_ns() - start_ns_.load(std::memory_order_relaxed));
+            r.address = reinterpret_cast<uintptr_t>(ptr);
+            r.size = static_cast<uint32_t>(bytes);
+            r.type = type;
+            r.op = op;
+            r.thread = buf.thread;
+        }
+
+        // 类型 T 的编号，第一次取得时写入类型定义记录
+        template <class T>
+        static uint16_t type_id()
+        {
+            static const uint16_t id = define_type(typeid(T).name());
+            return id;
+        }
+
+    private:
+        static int64_t now_ns() noexcept
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+        }
+        static thread_buffer &local()
+        {
+            thread_local thread_buffer buf;
+            return buf;
+        }
+        static uint16_t define_type(const char *name);
+        static void write_type(uint16_t id, const char *name);
+    };
+
+    inline alloc_trace::thread_buffer::thread_buffer()
+        : thread(static_cast<uint8_t>(next_thread_.fetch_add(1)))
+    {
+        std::lock_guard<std::mutex> registry(registry_mutex_);
+        buffers_.push_back(this);
+    }
+
+    // 线程退出时写入剩下的记录并注销
+    inline alloc_trace::thread_buffer::~thread_buffer()
+    {
+        std::lock_guard<std::mutex> registry(registry_mutex_);
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            flush();
+        }
+        for (size_t i = 0; i < buffers_.size(); ++i)
+        {
+            if (buffers_[i] == this)
+            {
+                buffers_[i] = buffers_.back();
+                buffers_.pop_back();
+                break;
+            }
+        }
+    }
+
+    inline void alloc_trace::thread_buffer::flush()
+    {
+        if (count == 0)
+            return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (file_ != nullptr)
+            std::fwrite(records, sizeof(alloc_trace_record), count, file_);
+        count = 0;
+    }
+
+    inline uint16_t alloc_trace::define_type(const char *name)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const uint16_t id = static_cast<uint16_t>(type_names_.size());
+        type_names_.push_back(name);
+        if (file_ != nullptr)
+            write_type(id, name);
+        return id;
+    }
+
+    // 写入一条类型定义记录，调用者需持有 mutex_
+    inline void alloc_trace::write_type(uint16_t id, const char *name)
+    {
+        alloc_trace_record r = {};
+        r.size = static_cast<uint32_t>(std::strlen(name));
+        r.type = id;
+        r.op = alloc_trace_record::define_type;
+        std::fwrite(&r, sizeof(r), 1, file_);
+        std::fwrite(name, 1, r.size, file_);
+        static const char zeros[8] = {};
+        std::fwrite(zeros, 1, (8 - r.size % 8) % 8, file_);
+    }
+} // namespace mystl
+#endif // !MYTINYSTL_ALLOC_TRACE_H_
@@ -1,12 +1,54 @@
 #ifndef MYTINYSTL_ALLOCATOR_H_
 #define MYTINYSTL_ALLOCATOR_H_
 
+#include <new>
+#include <type_traits>
+
 #include "construct.h"
 #include "destroy.h"
 #include "util.h"
 
+// 定义宏 MYSTL_USE_POOL_ALLOC 后，allocator<T> 的小对象请求交给二级配置器 pool_alloc
+// 这样 vector、list、basic_string 等所有使用 allocator<T> 的容器都会走内存池
+// 定义宏 MYSTL_USE_THREAD_CACHE_ALLOC 后，在内存池前面再加一层线程缓存 thread_cache_alloc
+// 定义宏 MYSTL_USE_REMOTE_FREE_ALLOC 后改用 remote_free_alloc，跨线程释放走无锁的 remote 队列
+#if defined(MYSTL_USE_REMOTE_FREE_ALLOC)
+#include "remote_free_alloc.h"
+#define MYSTL_SMALL_OBJECT_ALLOC mystl::remote_free_alloc
+#elif defined(MYSTL_USE_THREAD_CACHE_ALLOC)
+#include "thread_cache_alloc.h"
+#define MYSTL_SMALL_OBJECT_ALLOC mystl::thread_cache_alloc
+#elif defined(MYSTL_USE_POOL_ALLOC)
+#include "alloc.h"
+#define MYSTL_SMALL_OBJECT_ALLOC mystl::pool_alloc
+#endif
+
+// 定义宏 MYSTL_ALLOC_TRACE 后，allocator<T> 的分配与释放会写入 alloc_trace 的轨迹文件
+#ifdef MYSTL_ALLOC_TRACE
+#include "alloc_trace.h"
+#endif
+
+// 默认情况下大块请求使用 ::operator new / 带大小的 ::operator delete，替换过的 operator new 与
+// new_handler 都照常生效，allocate_at_least 只在内存池的大小等级里报告多出来的空间
+// 定义宏 MYSTL_USE_MALLOC_USABLE_SIZE 后（仅限 glibc），大块请求改用 malloc / free，
+// allocate_at_least 通过 malloc_usable_size 报告 malloc 多给的空间；
+// 代价是绕过了替换的 operator new 与 new_handler，释放时也不再传递大小
+#if defined(MYSTL_USE_MALLOC_USABLE_SIZE) && defined(__GLIBC__)
+#include <malloc.h>
+#include <cstdlib>
+#define MYSTL_HAS_MALLOC_USABLE_SIZE 1
+#endif
+
 namespace mystl
 {
+    // allocate_at_least 的返回值：分配到的空间与实际可以容纳的对象个数
+    template <class Pointer, class SizeType = size_t>
+    struct allocation_result
+    {
+        Pointer ptr;
+        SizeType count;
+    };
+
     template <typename T>
     class allocator
     {
@@ -21,10 +63,27 @@ namespace mystl
         //通常用来保存两个指针相减的结果，是有符号整数
         typedef ptrdiff_t difference_type;
 
+        template <typename U>
+        struct rebind
+        {
+            typedef allocator<U> other;
+        };
+
+        // 没有状态：移动赋值时可以直接接管对方的内存，任意两个实例都相等
+        typedef std::true_type propagate_on_container_move_assignment;
+        typedef std::true_type is_always_equal;
+
     public:
+        allocator() noexcept = default;
+        template <typename U>
+        allocator(const allocator<U> &) noexcept {}
+
         static pointer allocate();
         static pointer allocate(size_type n);
 
+        // 至少分配 n 个对象，count 为实际可用的个数，释放时可以传入 n 到 count 之间的任意值
+        static allocation_result<pointer, size_type> allocate_at_least(size_type n);
+
         static void deallocate(pointer ptr);
         static void deallocate(pointer ptr, size_type n);
 
@@ -37,30 +96,133 @@ namespace mystl
 
         static void destroy(pointer ptr);
         static void destroy(pointer first, pointer last);
+
+    private:
+        static void *allocate_bytes(size_type bytes);
+        static void deallocate_bytes(void *ptr, size_type bytes);
+        static void *heap_allocate(size_type bytes);
+        static void heap_deallocate(void *ptr, size_type bytes);
+        // 记录分配轨迹，未定义 MYSTL_ALLOC_TRACE 时为空
+        static void trace(bool is_allocate, const void *ptr, size_type bytes)
+        {
+#ifdef MYSTL_ALLOC_TRACE
+            alloc_trace::record(is_allocate ? alloc_trace_record::allocate : alloc_trace_record::deallocate,
+                                ptr, bytes, alloc_trace::type_id<T>());
+#else
+            (void)is_allocate;
+            (void)ptr;
+            (void)bytes;
+#endif
+        }
     };
     template <typename T>
     T *allocator<T>::allocate()
     {
-        return static_cast<pointer>(::operator new(sizeof(value_type)));
+        return allocate(1);
     }
     template <typename T>
     T *allocator<T>::allocate(size_type n)
     {
-        return static_cast<pointer>(::operator new(n * sizeof(value_type)));
+        void *ptr = allocate_bytes(n * sizeof(value_type));
+        trace(true, ptr, n * sizeof(value_type));
+        return static_cast<pointer>(ptr);
     }
+    // 不带大小的版本视为释放一个对象
     template <typename T>
     void allocator<T>::deallocate(T *ptr)
+    {
+        deallocate(ptr, 1);
+    }
+    // n 必须与分配时的个数一致
+    template <typename T>
+    void allocator<T>::deallocate(T *ptr, size_t n)
     {
         if (ptr == nullptr)
             return;
-        ::operator delete(ptr);
+        trace(false, ptr, n * sizeof(value_type));
+        deallocate_bytes(ptr, n * sizeof(value_type));
     }
     template <typename T>
-    void allocator<T>::deallocate(T *ptr, size_t /*size*/)
+    allocation_result<T *, size_t> allocator<T>::allocate_at_least(size_type n)
     {
-        if (ptr == nullptr)
+#if defined(MYSTL_SMALL_OBJECT_ALLOC) || defined(MYSTL_HAS_MALLOC_USABLE_SIZE)
+        const size_type bytes = n * sizeof(value_type);
+#endif
+#ifdef MYSTL_SMALL_OBJECT_ALLOC
+        // 内存池按 align 上调区块大小，上调出来的部分也可以使用
+        if (alignof(T) <= MYSTL_SMALL_OBJECT_ALLOC::align && bytes <= MYSTL_SMALL_OBJECT_ALLOC::max_bytes)
+        {
+            const size_type align = MYSTL_SMALL_OBJECT_ALLOC::align;
+            const size_type real = ((bytes == 0 ? 1 : bytes) + align - 1) & ~(align - 1);
+            void *ptr = MYSTL_SMALL_OBJECT_ALLOC::allocate(real);
+            trace(true, ptr, real / sizeof(value_type) * sizeof(value_type));
+            return {static_cast<pointer>(ptr), real / sizeof(value_type)};
+        }
+#endif
+#ifdef MYSTL_HAS_MALLOC_USABLE_SIZE
+        if (alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        {
+            void *ptr = heap_allocate(bytes);
+            const size_type count = ::malloc_usable_size(ptr) / sizeof(value_type);
+            trace(true, ptr, count * sizeof(value_type));
+            return {static_cast<pointer>(ptr), count};
+        }
+#endif
+        return {allocate(n), n};
+    }
+    template <typename T>
+    void *allocator<T>::allocate_bytes(size_type bytes)
+    {
+#ifdef MYSTL_SMALL_OBJECT_ALLOC
+        // 内存池只保证 8 字节对齐，对齐要求更高的类型仍走 ::operator new
+        if (alignof(T) <= MYSTL_SMALL_OBJECT_ALLOC::align && bytes <= MYSTL_SMALL_OBJECT_ALLOC::max_bytes)
+            return MYSTL_SMALL_OBJECT_ALLOC::allocate(bytes);
+#endif
+        // 对齐要求超过 ::operator new 默认保证的类型，使用带对齐参数的版本
+        if (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            return ::operator new(bytes, std::align_val_t(alignof(T)));
+        return heap_allocate(bytes);
+    }
+    template <typename T>
+    void allocator<T>::deallocate_bytes(void *ptr, size_type bytes)
+    {
+#ifdef MYSTL_SMALL_OBJECT_ALLOC
+        if (alignof(T) <= MYSTL_SMALL_OBJECT_ALLOC::align && bytes <= MYSTL_SMALL_OBJECT_ALLOC::max_bytes)
+        {
+            MYSTL_SMALL_OBJECT_ALLOC::deallocate(ptr, bytes);
+            return;
+        }
+#endif
+        if (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        {
+            ::operator delete(ptr, bytes, std::align_val_t(alignof(T)));
             return;
-        ::operator delete(ptr);
+        }
+        heap_deallocate(ptr, bytes);
+    }
+    // 默认对齐的大块请求
+    template <typename T>
+    void *allocator<T>::heap_allocate(size_type bytes)
+    {
+#ifdef MYSTL_HAS_MALLOC_USABLE_SIZE
+        void *ptr = std::malloc(bytes == 0 ? 1 : bytes);
+        if (ptr == nullptr)
+            throw std::bad_alloc();
+        return ptr;
+#else
+        return ::operator new(bytes);
+#endif
+    }
+    template <typename T>
+    void allocator<T>::heap_deallocate(void *ptr, size_type bytes)
+    {
+#ifdef MYSTL_HAS_MALLOC_USABLE_SIZE
+        // glibc 的 free 从块头部取得大小，用不到 bytes
+        (void)bytes;
+        std::free(ptr);
+#else
+        ::operator delete(ptr, bytes);
+#endif
     }
     template <typename T>
     void allocator<T>::construct(T *ptr)
@@ -88,13 +250,23 @@ namespace mystl
     {
         mystl::destroy(ptr);
     }
-    /*根据迭代器来析构，需要先完成迭代器类
     template <typename T>
     void allocator<T>::destroy(T *first, T *last)
     {
         mystl::destroy(first, last);
     }
-    */
+
+    // allocator 没有状态，任意两个实例都可以互相释放对方分配的内存
+    template <typename T, typename U>
+    bool operator==(const allocator<T> &, const allocator<U> &) noexcept
+    {
+        return true;
+    }
+    template <typename T, typename U>
+    bool operator!=(const allocator<T> &, const allocator<U> &) noexcept
+    {
+        return false;
+    }
 } //namespace mystl
 
 #endif
\ No newline at end of file
@@ -0,0 +1,228 @@
+#ifndef MYTINYSTL_ALLOCATOR_TRAITS_H_
+#define MYTINYSTL_ALLOCATOR_TRAITS_H_
+
+// 这个头文件包含模板类 allocator_traits，用于萃取空间配置器的特性
+// 容器通过它使用配置器的实例，因此既可以使用无状态的 allocator<T>，
+// 也可以使用 pmr::polymorphic_allocator<T> 这类带状态的配置器
+
+#include <cstddef>
+#include <type_traits>
+
+#include "allocator.h"
+#include "construct.h"
+#include "destroy.h"
+#include "pointer_traits.h"
+#include "util.h"
+
+namespace mystl
+{
+    // 萃取配置器中的传播特性，配置器没有定义时使用默认值
+#define MYSTL_ALLOC_TRAIT_DETECTOR(name, default_type)                                 \
+    template <class Alloc, class = void>                                               \
+    struct alloc_##name                                                                \
+    {                                                                                  \
+        typedef default_type type;                                                     \
+    };                                                                                 \
+    template <class Alloc>                                                             \
+    struct alloc_##name<Alloc, std::void_t<typename Alloc::name>>                      \
+    {                                                                                  \
+        typedef typename Alloc::name type;                                             \
+    };
+
+    MYSTL_ALLOC_TRAIT_DETECTOR(propagate_on_container_copy_assignment, std::false_type)
+    MYSTL_ALLOC_TRAIT_DETECTOR(propagate_on_container_move_assignment, std::false_type)
+    MYSTL_ALLOC_TRAIT_DETECTOR(propagate_on_container_swap, std::false_type)
+    MYSTL_ALLOC_TRAIT_DETECTOR(is_always_equal, typename std::is_empty<Alloc>::type)
+
+#undef MYSTL_ALLOC_TRAIT_DETECTOR
+
+    // 配置器是否定义了 select_on_container_copy_construction
+    template <class Alloc, class = void>
+    struct has_select_on_copy : std::false_type
+    {
+    };
+    template <class Alloc>
+    struct has_select_on_copy<Alloc, std::void_t<decltype(std::declval<const Alloc &>()
+                                                              .select_on_container_copy_construction())>>
+        : std::true_type
+    {
+    };
+
+    // 配置器是否提供 allocate_at_least
+    template <class Alloc, class = void>
+    struct has_allocate_at_least : std::false_type
+    {
+    };
+    template <class Alloc>
+    struct has_allocate_at_least<Alloc, std::void_t<decltype(std::declval<Alloc &>()
+                                                                 .allocate_at_least(size_t(1)))>>
+        : std::true_type
+    {
+    };
+
+    // 配置器是否提供 reallocate(ptr, old_n, new_n)：不逐个复制元素就改变区块的大小
+    template <class Alloc, class = void>
+    struct has_reallocate : std::false_type
+    {
+    };
+    template <class Alloc>
+    struct has_reallocate<Alloc, std::void_t<decltype(std::declval<Alloc &>().reallocate(
+                                     std::declval<typename Alloc::pointer>(), size_t(1), size_t(1)))>>
+        : std::true_type
+    {
+    };
+
+    template <class Alloc>
+    struct allocator_traits
+    {
+        typedef Alloc allocator_type;
+        typedef typename Alloc::value_type value_type;
+        typedef typename Alloc::pointer pointer;
+        typedef typename Alloc::const_pointer const_pointer;
+        typedef typename Alloc::size_type size_type;
+        typedef typename Alloc::difference_type difference_type;
+        // pointer 可以是 offset_ptr 这类 fancy pointer，void_pointer 是与之对应的无类型指针
+        typedef typename mystl::pointer_traits<pointer>::template rebind<void> void_pointer;
+
+        // 把配置器重新绑定到另一个类型上，例如 list 用它得到结点的配置器
+        template <class U>
+        using rebind_alloc = typename Alloc::template rebind<U>::other;
+
+        // 容器复制赋值、移动赋值、交换时，是否把配置器一起传播过去
+        typedef typename alloc_propagate_on_container_copy_assignment<Alloc>::type
+            propagate_on_container_copy_assignment;
+        typedef typename alloc_propagate_on_container_move_assignment<Alloc>::type
+            propagate_on_container_move_assignment;
+        typedef typename alloc_propagate_on_container_swap<Alloc>::type
+            propagate_on_container_swap;
+        // 任意两个实例是否总是相等，相等的配置器可以释放对方分配的内存
+        typedef typename alloc_is_always_equal<Alloc>::type is_always_equal;
+
+        static pointer allocate(Alloc &a, size_type n)
+        {
+            return a.allocate(n);
+        }
+        // 至少分配 n 个对象，返回实际可用的个数，配置器不支持时就是 n
+        static allocation_result<pointer, size_type> allocate_at_least(Alloc &a, size_type n)
+        {
+            return allocate_at_least(a, n, has_allocate_at_least<Alloc>{});
+        }
+        static void deallocate(Alloc &a, pointer ptr, size_type n)
+        {
+            a.deallocate(ptr, n);
+        }
+        // 把 old_n 个对象的区块改为 new_n 个，内容按字节保留（例如 mremap），
+        // 配置器不支持或这次做不到时返回空指针，原区块不变
+        static pointer reallocate(Alloc &a, pointer ptr, size_type old_n, size_type new_n)
+        {
+            return reallocate(a, ptr, old_n, new_n, has_reallocate<Alloc>{});
+        }
+
+        // 对象的构造与析构不涉及内存来源，统一交给 construct / destroy
+        template <class T, class... Args>
+        static void construct(Alloc &, T *ptr, Args &&...args)
+        {
+            mystl::construct(ptr, mystl::forward<Args>(args)...);
+        }
+        template <class T>
+        static void destroy(Alloc &, T *ptr)
+        {
+            mystl::destroy(ptr);
+        }
+        template <class ForwardIter>
+        static void destroy(Alloc &, ForwardIter first, ForwardIter last)
+        {
+            mystl::destroy(first, last);
+        }
+
+        // 复制构造容器时新容器使用的配置器
+        static Alloc select_on_container_copy_construction(const Alloc &a)
+        {
+            return select_on_copy(a, has_select_on_copy<Alloc>{});
+        }
+
+        // 根据传播特性对配置器做复制赋值、移动赋值和交换
+        static void copy_assign(Alloc &lhs, const Alloc &rhs)
+        {
+            copy_assign(lhs, rhs, propagate_on_container_copy_assignment{});
+        }
+        static void move_assign(Alloc &lhs, Alloc &rhs)
+        {
+            move_assign(lhs, rhs, propagate_on_container_move_assignment{});
+        }
+        static void swap(Alloc &lhs, Alloc &rhs)
+        {
+            swap(lhs, rhs, propagate_on_container_swap{});
+        }
+
+    private:
+        static allocation_result<pointer, size_type>
+        allocate_at_least(Alloc &a, size_type n, std::true_type)
+        {
+            auto result = a.allocate_at_least(n);
+            return {result.ptr, result.count};
+        }
+        static allocation_result<pointer, size_type>
+        allocate_at_least(Alloc &a, size_type n, std::false_type)
+        {
+            return {a.allocate(n), n};
+        }
+        static pointer reallocate(Alloc &a, pointer ptr, size_type old_n, size_type new_n, std::true_type)
+        {
+            return a.reallocate(ptr, old_n, new_n);
+        }
+        static pointer reallocate(Alloc &, pointer, size_type, size_type, std::false_type)
+        {
+            return pointer();
+        }
+        static Alloc select_on_copy(const Alloc &a, std::true_type)
+        {
+            return a.select_on_container_copy_construction();
+        }
+        static Alloc select_on_copy(const Alloc &a, std::false_type)
+        {
+            return a;
+        }
+        static void copy_assign(Alloc &lhs, const Alloc &rhs, std::true_type) { lhs = rhs; }
+        static void copy_assign(Alloc &, const Alloc &, std::false_type) {}
+        static void move_assign(Alloc &lhs, Alloc &rhs, std::true_type) { lhs = mystl::move(rhs); }
+        static void move_assign(Alloc &, Alloc &, std::false_type) {}
+        static void swap(Alloc &lhs, Alloc &rhs, std::true_type)
+        {
+            Alloc tmp(mystl::move(lhs));
+            lhs = mystl::move(rhs);
+            rhs = mystl::move(tmp);
+        }
+        static void swap(Alloc &, Alloc &, std::false_type) {}
+    };
+
+    // --------------------------------------------------------------------------------------
+    // 模板类：allocator_holder
+    // 容器私有继承它来存放配置器，空的配置器利用空基类优化不占空间，
+    // 因此使用 allocator<T> 的容器大小与不存放配置器时相同
+    template <class Alloc, bool = std::is_empty<Alloc>::value && !std::is_final<Alloc>::value>
+    class allocator_holder : private Alloc
+    {
+    public:
+        allocator_holder() noexcept(noexcept(Alloc())) : Alloc() {}
+        explicit allocator_holder(const Alloc &a) noexcept : Alloc(a) {}
+
+        Alloc &get() noexcept { return *this; }
+        const Alloc &get() const noexcept { return *this; }
+    };
+
+    template <class Alloc>
+    class allocator_holder<Alloc, false>
+    {
+    private:
+        Alloc alloc_;
+
+    public:
+        allocator_holder() noexcept(noexcept(Alloc())) : alloc_() {}
+        explicit allocator_holder(const Alloc &a) noexcept : alloc_(a) {}
+
+        Alloc &get() noexcept { return alloc_; }
+        const Alloc &get() const noexcept { return alloc_; }
+    };
+} // namespace mystl
+#endif // !MYTINYSTL_ALLOCATOR_TRAITS_H_
@@ -0,0 +1,141 @@
+#ifndef MYTINYSTL_BIT_OPS_H_
+#define MYTINYSTL_BIT_OPS_H_
+
+// 这个头文件包含按 64 位字处理位集合的函数，供 bit_vector 使用
+// popcount64 / countr_zero64 : GCC、Clang 下使用内建函数，编译时开启 -mpopcnt / -mbmi（或 -march=native）
+//                              会变成单条 popcnt / tzcnt 指令
+// bitwise_words<Op>          : dst[i] = Op(dst[i], src[i])，编译时开启 AVX2 时一次处理 4 个字，
+//                              否则在 SSE2 下一次处理 2 个字，其余平台逐字处理
+// count_words / count_and_words : 统计 1 的个数，后者统计 a & b 而不写回
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace mystl
+{
+    inline unsigned popcount64(uint64_t x) noexcept
+    {
+#if defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_popcountll(x));
+#else
+        x = x - ((x >> 1) & 0x5555555555555555ULL);
+        x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+        x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+        return static_cast<unsigned>((x * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+
+    // 最低位的 1 的下标，x 不能为 0
+    inline unsigned countr_zero64(uint64_t x) noexcept
+    {
+#if defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_ctzll(x));
+#else
+        unsigned n = 0;
+        for (; (x & 1) == 0; x >>= 1)
+            ++n;
+        return n;
+#endif
+    }
+
+    // --------------------------------------------------------------------------------------
+    // 逐字运算，apply 同时提供标量与向量两个版本
+    struct word_and
+    {
+        static uint64_t apply(uint64_t a, uint64_t b) noexcept { return a & b; }
+#if defined(__AVX2__)
+        static __m256i apply(__m256i a, __m256i b) noexcept { return _mm256_and_si256(a, b); }
+#elif defined(__SSE2__)
+        static __m128i apply(__m128i a, __m128i b) noexcept { return _mm_and_si128(a, b); }
+#endif
+    };
+    struct word_or
+    {
+        static uint64_t apply(uint64_t a, uint64_t b) noexcept { return a | b; }
+#if defined(__AVX2__)
+        static __m256i apply(__m256i a, __m256i b) noexcept { return _mm256_or_si256(a, b); }
+#elif defined(__SSE2__)
+        static __m128i apply(__m128i a, __m128i b) noexcept { return _mm_or_si128(a, b); }
+#endif
+    };
+    struct word_xor
+    {
+        static uint64_t apply(uint64_t a, uint64_t b) noexcept { return a ^ b; }
+#if defined(__AVX2__)
+        static __m256i apply(__m256i a, __m256i b) noexcept { return _mm256_xor_si256(a, b); }
+#elif defined(__SSE2__)
+        static __m128i apply(__m128i a, __m128i b) noexcept { return _mm_xor_si128(a, b); }
+#endif
+    };
+    // a & ~b
+    struct word_and_not
+    {
+        static uint64_t apply(uint64_t a, uint64_t b) noexcept { return a & ~b; }
+#if defined(__AVX2__)
+        static __m256i apply(__m256i a, __m256i b) noexcept { return _mm256_andnot_si256(b, a); }
+#elif defined(__SSE2__)
+        static __m128i apply(__m128i a, __m128i b) noexcept { return _mm_andnot_si128(b, a); }
+#endif
+    };
+
+    template <class Op>
+    void bitwise_words(uint64_t *dst, const uint64_t *src, size_t n) noexcept
+    {
+        size_t i = 0;
+#if defined(__AVX2__)
+        for (; i + 4 <= n; i += 4)
+        {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), Op::apply(a, b));
+        }
+#elif defined(__SSE2__)
+        for (; i + 2 <= n; i += 2)
+        {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), Op::apply(a, b));
+        }
+#endif
+        for (; i < n; ++i)
+            dst[i] = Op::apply(dst[i], src[i]);
+    }
+
+    // 四个累加器交替使用，popcnt 指令之间没有依赖
+    inline size_t count_words(const uint64_t *words, size_t n) noexcept
+    {
+        size_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            c0 += popcount64(words[i]);
+            c1 += popcount64(words[i + 1]);
+            c2 += popcount64(words[i + 2]);
+            c3 += popcount64(words[i + 3]);
+        }
+        for (; i < n; ++i)
+            c0 += popcount64(words[i]);
+        return c0 + c1 + c2 + c3;
+    }
+
+    inline size_t count_and_words(const uint64_t *a, const uint64_t *b, size_t n) noexcept
+    {
+        size_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            c0 += popcount64(a[i] & b[i]);
+            c1 += popcount64(a[i + 1] & b[i + 1]);
+            c2 += popcount64(a[i + 2] & b[i + 2]);
+            c3 += popcount64(a[i + 3] & b[i + 3]);
+        }
+        for (; i < n; ++i)
+            c0 += popcount64(a[i] & b[i]);
+        return c0 + c1 + c2 + c3;
+    }
+} // namespace mystl
+#endif // !MYTINYSTL_BIT_OPS_H_
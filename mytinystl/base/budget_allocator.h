@@ -0,0 +1,258 @@
+#ifndef MYTINYSTL_BUDGET_ALLOCATOR_H_
+#define MYTINYSTL_BUDGET_ALLOCATOR_H_
+
+// 这个头文件包含内存预算 memory_budget 与包装配置器 budget_allocator，用于限制各子系统的堆内存
+// budget_allocator<T, Tag, Alloc> 在把请求转发给 Alloc 之前，先在 Tag 对应的 memory_budget 上记账：
+//   软上限 soft_limit : 占用向上越过时回调 soft_limit_exceeded，回落到软上限以下时回调
+//                       soft_limit_recovered，调用者可以据此限流（背压），也可以随时查询 over_soft_limit()
+//   硬上限 hard_limit : 占用将超过时回调 hard_limit_exceeded；开启 fail_fast 时这次分配直接抛出
+//                       std::bad_alloc，不会调用底层的配置器，否则只回调、照常分配
+// 记账只是一次 relaxed 的 fetch_add 和几次比较，可以在生产环境中一直开启
+//   例：struct cache_budget { static constexpr const char *name = "cache"; };
+//       mystl::budget_of<cache_budget>().set_limits(64 << 20, 128 << 20, true);
+//       mystl::vector<int, mystl::budget_allocator<int, cache_budget>> v;
+// 每个 Tag 一个预算，Tag 定义了 static 成员 name 时用它作名字；memory_budget::find(name) 按名字查找
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+
+#include "allocator.h"
+#include "allocator_traits.h"
+
+namespace mystl
+{
+    class memory_budget;
+
+    enum class budget_event
+    {
+        soft_limit_exceeded,  // 占用越过软上限
+        soft_limit_recovered, // 占用回落到软上限以下
+        hard_limit_exceeded   // 一次分配将超过硬上限
+    };
+
+    // 回调在分配或释放的线程中执行，bytes 为触发这次事件的请求大小，不能抛出异常
+    typedef void (*budget_callback)(const memory_budget &budget, budget_event event, size_t bytes,
+                                    void *context);
+
+    // --------------------------------------------------------------------------------------
+    // 类：memory_budget
+    // 所有预算串在一个全局链表上，以便按名字查找
+    class memory_budget
+    {
+    public:
+        static constexpr size_t unlimited = static_cast<size_t>(-1);
+
+    private:
+        const char *name_;
+        std::atomic<size_t> used_{0};
+        std::atomic<size_t> peak_{0};
+        std::atomic<size_t> rejected_{0}; // fail_fast 拒绝的次数
+        std::atomic<size_t> soft_limit_{unlimited};
+        std::atomic<size_t> hard_limit_{unlimited};
+        std::atomic<bool> fail_fast_{false};
+        std::atomic<budget_callback> callback_{nullptr};
+        std::atomic<void *> context_{nullptr};
+        memory_budget *next_;
+
+        inline static std::atomic<memory_budget *> head_{nullptr};
+
+    public:
+        explicit memory_budget(const char *name) noexcept
+            : name_(name), next_(head_.load(std::memory_order_relaxed))
+        {
+            while (!head_.compare_exchange_weak(next_, this, std::memory_order_release,
+                                                std::memory_order_relaxed))
+            {
+            }
+        }
+        memory_budget(const memory_budget &) = delete;
+        memory_budget &operator=(const memory_budget &) = delete;
+
+        // 设置上限，通常在启动时调用
+        void set_limits(size_t soft_limit, size_t hard_limit, bool fail_fast = false) noexcept
+        {
+            soft_limit_.store(soft_limit, std::memory_order_relaxed);
+            hard_limit_.store(hard_limit, std::memory_order_relaxed);
+            fail_fast_.store(fail_fast, std::memory_order_relaxed);
+        }
+        void set_callback(budget_callback callback, void *context = nullptr) noexcept
+        {
+            context_.store(context, std::memory_order_relaxed);
+            callback_.store(callback, std::memory_order_release);
+        }
+
+        // 记入 bytes 字节，fail_fast 时超过硬上限抛出 std::bad_alloc 且不记账
+        void charge(size_t bytes);
+        // 归还 bytes 字节
+        void release(size_t bytes) noexcept;
+
+        const char *name() const noexcept { return name_; }
+        size_t used() const noexcept { return used_.load(std::memory_order_relaxed); }
+        size_t peak() const noexcept { return peak_.load(std::memory_order_relaxed); }
+        size_t rejected() const noexcept { return rejected_.load(std::memory_order_relaxed); }
+        size_t soft_limit() const noexcept { return soft_limit_.load(std::memory_order_relaxed); }
+        size_t hard_limit() const noexcept { return hard_limit_.load(std::memory_order_relaxed); }
+        bool over_soft_limit() const noexcept { return used() > soft_limit(); }
+
+        // 按名字查找预算，没有时返回 nullptr
+        static memory_budget *find(const char *name) noexcept
+        {
+            for (memory_budget *p = head_.load(std::memory_order_acquire); p != nullptr; p = p->next_)
+            {
+                if (std::strcmp(p->name_, name) == 0)
+                    return p;
+            }
+            return nullptr;
+        }
+
+    private:
+        void notify(budget_event event, size_t bytes) const noexcept
+        {
+            budget_callback callback = callback_.load(std::memory_order_acquire);
+            if (callback != nullptr)
+                callback(*this, event, bytes, context_.load(std::memory_order_relaxed));
+        }
+    };
+
+    inline void memory_budget::charge(size_t bytes)
+    {
+        const size_t old_used = used_.fetch_add(bytes, std::memory_order_relaxed);
+        const size_t new_used = old_used + bytes;
+        if (new_used > hard_limit_.load(std::memory_order_relaxed))
+        {
+            notify(budget_event::hard_limit_exceeded, bytes);
+            if (fail_fast_.load(std::memory_order_relaxed))
+            {
+                used_.fetch_sub(bytes, std::memory_order_relaxed);
+                rejected_.fetch_add(1, std::memory_order_relaxed);
+                throw std::bad_alloc();
+            }
+        }
+        const size_t soft = soft_limit_.load(std::memory_order_relaxed);
+        if (old_used <= soft && new_used > soft)
+            notify(budget_event::soft_limit_exceeded, bytes);
+        size_t peak = peak_.load(std::memory_order_relaxed);
+        while (new_used > peak &&
+               !peak_.compare_exchange_weak(peak, new_used, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    inline void memory_budget::release(size_t bytes) noexcept
+    {
+        const size_t old_used = used_.fetch_sub(bytes, std::memory_order_relaxed);
+        const size_t soft = soft_limit_.load(std::memory_order_relaxed);
+        if (old_used > soft && old_used - bytes <= soft)
+            notify(budget_event::soft_limit_recovered, bytes);
+    }
+
+    // 取得 Tag 对应的预算，Tag 定义了 static 成员 name 时用它作名字
+    template <class Tag, class = void>
+    struct memory_budget_name
+    {
+        static const char *get() noexcept { return typeid(Tag).name(); }
+    };
+    template <class Tag>
+    struct memory_budget_name<Tag, std::void_t<decltype(Tag::name)>>
+    {
+        static const char *get() noexcept { return Tag::name; }
+    };
+
+    template <class Tag>
+    memory_budget &budget_of()
+    {
+        static memory_budget budget(memory_budget_name<Tag>::get());
+        return budget;
+    }
+
+    // --------------------------------------------------------------------------------------
+    // 模板类：budget_allocator
+    // 不保存预算的指针，没有状态的 Alloc 包装后仍然是空类，不增加容器的大小
+    template <class T, class Tag, class Alloc = mystl::allocator<T>>
+    class budget_allocator : private mystl::allocator_holder<Alloc>
+    {
+    private:
+        typedef mystl::allocator_holder<Alloc> alloc_base;
+        typedef mystl::allocator_traits<Alloc> base_traits;
+
+    public:
+        typedef T value_type;
+        typedef typename base_traits::pointer pointer;
+        typedef typename base_traits::const_pointer const_pointer;
+        typedef T &reference;
+        typedef const T &const_reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        template <class U>
+        struct rebind
+        {
+            typedef budget_allocator<U, Tag, typename base_traits::template rebind_alloc<U>> other;
+        };
+
+        typedef typename base_traits::propagate_on_container_copy_assignment
+            propagate_on_container_copy_assignment;
+        typedef typename base_traits::propagate_on_container_move_assignment
+            propagate_on_container_move_assignment;
+        typedef typename base_traits::propagate_on_container_swap propagate_on_container_swap;
+        typedef typename base_traits::is_always_equal is_always_equal;
+
+    public:
+        budget_allocator() = default;
+        budget_allocator(const Alloc &a) : alloc_base(a) {}
+        template <class U, class A>
+        budget_allocator(const budget_allocator<U, Tag, A> &other)
+            : alloc_base(Alloc(other.base()))
+        {
+        }
+
+        // 先记账再分配，底层分配失败时把账退回
+        pointer allocate(size_type n)
+        {
+            const size_t bytes = n * sizeof(T);
+            budget().charge(bytes);
+            try
+            {
+                return base_traits::allocate(this->get(), n);
+            }
+            catch (...)
+            {
+                budget().release(bytes);
+                throw;
+            }
+        }
+        void deallocate(pointer ptr, size_type n)
+        {
+            if (ptr == nullptr)
+                return;
+            budget().release(n * sizeof(T));
+            base_traits::deallocate(this->get(), ptr, n);
+        }
+
+        budget_allocator select_on_container_copy_construction() const
+        {
+            return budget_allocator(base_traits::select_on_container_copy_construction(base()));
+        }
+
+        const Alloc &base() const noexcept { return this->get(); }
+
+        static memory_budget &budget() { return budget_of<Tag>(); }
+    };
+
+    template <class T, class U, class Tag, class A1, class A2>
+    bool operator==(const budget_allocator<T, Tag, A1> &lhs, const budget_allocator<U, Tag, A2> &rhs)
+    {
+        return lhs.base() == rhs.base();
+    }
+    template <class T, class U, class Tag, class A1, class A2>
+    bool operator!=(const budget_allocator<T, Tag, A1> &lhs, const budget_allocator<U, Tag, A2> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+} // namespace mystl
+#endif // !MYTINYSTL_BUDGET_ALLOCATOR_H_
@@ -7,6 +7,7 @@
 
 #include "type_traits.h"
 #include "iterator.h"
+#include "util.h"
 
 namespace mystl
 {
@@ -24,8 +25,8 @@ namespace mystl
     template <typename T, typename T_>
     void construct(T *ptr, T_ &&value)
     {
-        // 没搞懂为啥要用T_
-        ::new ((void *)ptr) T_(value);
+        // T_ 是万能引用，用 forward 保持实参的左值/右值属性
+        ::new ((void *)ptr) T(mystl::forward<T_>(value));
     }
     template <typename T, typename... Args>
     void construct(T *ptr, Args &&...args)
@@ -5,6 +5,8 @@
 #include <new>
 #include <type_traits>
 
+#include "iterator.h"
+
 namespace mystl
 {
     template <typename T>
@@ -15,7 +17,7 @@ namespace mystl
     {
         if (pointer != nullptr)
         {
-            pointer->~Ty();
+            pointer->~T();
         }
     }
 
@@ -24,11 +26,23 @@ namespace mystl
     {
         destroy_one(pointer, std::is_trivially_destructible<T>{});
     }
-    /*应该先完成迭代器类
-    template <typename T>
-    void destroy(T *first, T *second)
+
+    template <class ForwardIter>
+    void destroy_cat(ForwardIter, ForwardIter, std::true_type) {}
+
+    template <class ForwardIter>
+    void destroy_cat(ForwardIter first, ForwardIter last, std::false_type)
+    {
+        for (; first != last; ++first)
+            destroy(&*first);
+    }
+
+    // 析构[first, last)上的对象，平凡析构的类型什么都不做
+    template <class ForwardIter>
+    void destroy(ForwardIter first, ForwardIter last)
     {
+        destroy_cat(first, last, std::is_trivially_destructible<
+                                     typename iterator_traits<ForwardIter>::value_type>{});
     }
-    */
 }
-#endif
\ No newline at end of file
+#endif
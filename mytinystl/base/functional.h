@@ -8,6 +8,13 @@
 namespace mystl
 {
 
+    // 函数对象：小于
+    template <class T>
+    struct less
+    {
+        bool operator()(const T &x, const T &y) const { return x < y; }
+    };
+
     /*******************************************************************************/
     // 哈希函数对象
     // 对于大部分类型，hash function什么都不做
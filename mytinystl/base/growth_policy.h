@@ -0,0 +1,113 @@
+#ifndef MYTINYSTL_GROWTH_POLICY_H_
+#define MYTINYSTL_GROWTH_POLICY_H_
+
+// 这个头文件包含 vector 的扩容策略，作为 vector 的第三个模板参数
+// 策略提供两个成员：
+//   next_capacity(old_cap, required, max_size) : 容量不足时的新容量（元素个数），
+//                                                vector 会再把结果限制在 [required, max_size] 之间
+//   on_reallocate(bytes_moved)                 : 每次重新分配后调用，bytes_moved 为搬移的元素字节数
+// geometric_growth<Num, Den, Min>             : 按 Num / Den 倍扩容，growth_1_5x 为默认策略，growth_2x 为两倍
+// fixed_step_growth<Step>                     : 每次增加 Step 个元素，内存占用最省，但追加是 O(n^2) 的
+// capped_geometric_growth<MaxStep, Num, Den>  : 按倍数扩容，但每次最多增加 MaxStep 个元素，
+//                                                适合对内存峰值敏感的服务
+// growth_stats<Policy>                        : 包装任意策略，统计这个 vector 的重新分配次数和搬移的字节数；
+//                                                不使用时策略是空类，vector 利用空基类优化不增加大小
+//   例：mystl::vector<int, mystl::allocator<int>, mystl::growth_stats<mystl::growth_2x>> v;
+//       ... v.get_growth_policy().reallocations(), v.get_growth_policy().bytes_moved()
+// 策略属于每个 vector 实例，复制、移动 vector 时不随元素一起转移
+
+#include <cstddef>
+
+namespace mystl
+{
+    // old_cap * Num / Den - old_cap，溢出时返回 max_size
+    inline size_t geometric_increment(size_t old_cap, size_t num, size_t den, size_t max_size) noexcept
+    {
+        const size_t extra = num - den;
+        if (old_cap > max_size / extra)
+            return max_size;
+        return old_cap * extra / den;
+    }
+
+    // 增加 inc 个元素后的容量，不超过 max_size
+    inline size_t add_capacity(size_t old_cap, size_t inc, size_t max_size) noexcept
+    {
+        return inc > max_size - old_cap ? max_size : old_cap + inc;
+    }
+
+    // --------------------------------------------------------------------------------------
+    // 按倍数扩容，空的 vector 第一次至少分配 Min 个元素
+    template <size_t Num, size_t Den, size_t Min = 16>
+    struct geometric_growth
+    {
+        static_assert(Den > 0 && Num > Den, "growth factor must be greater than 1");
+
+        size_t next_capacity(size_t old_cap, size_t required, size_t max_size) const noexcept
+        {
+            if (old_cap == 0)
+                return required < Min ? Min : required;
+            return add_capacity(old_cap, geometric_increment(old_cap, Num, Den, max_size), max_size);
+        }
+        void on_reallocate(size_t) noexcept {}
+    };
+
+    typedef geometric_growth<3, 2> growth_1_5x;
+    typedef geometric_growth<2, 1> growth_2x;
+
+    // 每次增加 Step 个元素
+    template <size_t Step>
+    struct fixed_step_growth
+    {
+        static_assert(Step > 0, "growth step must be positive");
+
+        size_t next_capacity(size_t old_cap, size_t, size_t max_size) const noexcept
+        {
+            return add_capacity(old_cap, Step, max_size);
+        }
+        void on_reallocate(size_t) noexcept {}
+    };
+
+    // 按倍数扩容，每次最多增加 MaxStep 个元素
+    template <size_t MaxStep, size_t Num = 2, size_t Den = 1, size_t Min = 16>
+    struct capped_geometric_growth
+    {
+        static_assert(Den > 0 && Num > Den, "growth factor must be greater than 1");
+        static_assert(MaxStep > 0, "growth step must be positive");
+
+        size_t next_capacity(size_t old_cap, size_t required, size_t max_size) const noexcept
+        {
+            if (old_cap == 0)
+                return required < Min ? Min : required;
+            const size_t inc = geometric_increment(old_cap, Num, Den, max_size);
+            return add_capacity(old_cap, inc < MaxStep ? inc : MaxStep, max_size);
+        }
+        void on_reallocate(size_t) noexcept {}
+    };
+
+    // --------------------------------------------------------------------------------------
+    // 统计重新分配，Policy 决定新容量
+    template <class Policy>
+    class growth_stats : public Policy
+    {
+    private:
+        size_t reallocations_ = 0;
+        size_t bytes_moved_ = 0;
+
+    public:
+        void on_reallocate(size_t bytes_moved) noexcept
+        {
+            ++reallocations_;
+            bytes_moved_ += bytes_moved;
+            Policy::on_reallocate(bytes_moved);
+        }
+
+        size_t reallocations() const noexcept { return reallocations_; }
+        size_t bytes_moved() const noexcept { return bytes_moved_; }
+        void reset() noexcept
+        {
+            reallocations_ = 0;
+            bytes_moved_ = 0;
+        }
+    };
+} // namespace mystl
+#endif // !MYTINYSTL_GROWTH_POLICY_H_
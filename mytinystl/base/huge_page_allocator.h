@@ -0,0 +1,194 @@
+#ifndef MYTINYSTL_HUGE_PAGE_ALLOCATOR_H_
+#define MYTINYSTL_HUGE_PAGE_ALLOCATOR_H_
+
+// 这个头文件包含模板类 huge_page_allocator，用于几个 GB 的大缓冲区
+// 不小于 Threshold 字节的请求直接 mmap，按大页边界对齐后用 madvise(MADV_HUGEPAGE) 申请透明大页，
+// Populate 为 true 时在分配时就把页面全部缺页进来（作用同 MAP_POPULATE）
+// 小于 Threshold 的请求以及不支持 mmap 的平台仍然交给 allocator<T>
+// reallocate 在新旧大小都由 mmap 提供时用 mremap(MREMAP_MAYMOVE) 移动页表而不复制页面，
+// 只适用于可以按字节搬移的元素，由容器负责判断
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+#include "allocator.h"
+#include "exceptdef.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#define MYSTL_HAS_MMAP 1
+#endif
+
+namespace mystl
+{
+    // 大页的大小，x86-64 与 aarch64 上透明大页均为 2MB
+    constexpr size_t huge_page_size = size_t(2) << 20;
+
+    template <class T, size_t Threshold = huge_page_size, bool Populate = false>
+    class huge_page_allocator
+    {
+    public:
+        typedef T value_type;
+        typedef T *pointer;
+        typedef const T *const_pointer;
+        typedef T &reference;
+        typedef const T &const_reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        template <class U>
+        struct rebind
+        {
+            typedef huge_page_allocator<U, Threshold, Populate> other;
+        };
+
+        // 没有状态
+        typedef std::true_type propagate_on_container_move_assignment;
+        typedef std::true_type is_always_equal;
+
+        static_assert(alignof(T) <= huge_page_size, "alignment of T is too large");
+
+    public:
+        huge_page_allocator() noexcept = default;
+        template <class U>
+        huge_page_allocator(const huge_page_allocator<U, Threshold, Populate> &) noexcept {}
+
+        static pointer allocate(size_type n);
+        static void deallocate(pointer ptr, size_type n);
+        // 把 old_n 个对象的映射改为 new_n 个，做不到时返回空指针
+        static pointer reallocate(pointer ptr, size_type old_n, size_type new_n);
+
+        // n 个对象是否由 mmap 提供
+        static bool is_mapped(size_type n) noexcept
+        {
+#ifdef MYSTL_HAS_MMAP
+            return n * sizeof(T) >= Threshold;
+#else
+            (void)n;
+            return false;
+#endif
+        }
+
+    private:
+        // 字节数上调至大页的倍数
+        static size_type map_size(size_type n) noexcept
+        {
+            return (n * sizeof(T) + huge_page_size - 1) & ~(huge_page_size - 1);
+        }
+    };
+
+    template <class T, size_t Threshold, bool Populate>
+    T *huge_page_allocator<T, Threshold, Populate>::allocate(size_type n)
+    {
+        THROW_LENGTH_ERROR_IF(n > (static_cast<size_type>(-1) - huge_page_size) / sizeof(T),
+                              "huge_page_allocator<T>::allocate(n) too big");
+        if (!is_mapped(n))
+            return mystl::allocator<T>::allocate(n);
+#ifdef MYSTL_HAS_MMAP
+        // 多映射一个大页，再把首尾裁掉，使起始地址落在大页边界上
+        const size_type size = map_size(n);
+        const size_type raw_size = size + huge_page_size;
+        void *raw = ::mmap(nullptr, raw_size, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED)
+            throw std::bad_alloc();
+        const uintptr_t addr = reinterpret_cast<uintptr_t>(raw);
+        const uintptr_t aligned = (addr + huge_page_size - 1) & ~(uintptr_t(huge_page_size) - 1);
+        if (aligned != addr)
+            ::munmap(raw, aligned - addr);
+        const uintptr_t tail = addr + raw_size - (aligned + size);
+        if (tail != 0)
+            ::munmap(reinterpret_cast<void *>(aligned + size), tail);
+        void *result = reinterpret_cast<void *>(aligned);
+#ifdef MADV_HUGEPAGE
+        // 内核未开启透明大页时 madvise 失败，内存仍然可用，只是退回 4K 页
+        ::madvise(result, size, MADV_HUGEPAGE);
+#endif
+        if (Populate)
+        {
+#ifdef MADV_POPULATE_WRITE
+            // MAP_POPULATE 只能在 mmap 时给出，而大页提示要在 mmap 之后才能设置，
+            // 所以在 madvise 之后再主动预取，使预取的页面就是大页
+            if (::madvise(result, size, MADV_POPULATE_WRITE) != 0)
+#endif
+            {
+                volatile char *p = static_cast<char *>(result);
+                for (size_type i = 0; i < size; i += 4096)
+                    p[i] = 0;
+            }
+        }
+        return static_cast<pointer>(result);
+#else
+        return mystl::allocator<T>::allocate(n);
+#endif
+    }
+
+    // n 必须与分配时的个数一致，据此判断内存来自 mmap 还是 allocator<T>
+    template <class T, size_t Threshold, bool Populate>
+    void huge_page_allocator<T, Threshold, Populate>::deallocate(T *ptr, size_type n)
+    {
+        if (ptr == nullptr)
+            return;
+        if (!is_mapped(n))
+        {
+            mystl::allocator<T>::deallocate(ptr, n);
+            return;
+        }
+#ifdef MYSTL_HAS_MMAP
+        ::munmap(ptr, map_size(n));
+#endif
+    }
+
+    // 新地址不一定在大页边界上，内核仍会对其中对齐的 2MB 区间使用大页
+    template <class T, size_t Threshold, bool Populate>
+    T *huge_page_allocator<T, Threshold, Populate>::reallocate(T *ptr, size_type old_n, size_type new_n)
+    {
+#if defined(MYSTL_HAS_MMAP) && defined(MREMAP_MAYMOVE)
+        if (ptr == nullptr || !is_mapped(old_n) || !is_mapped(new_n))
+            return nullptr;
+        THROW_LENGTH_ERROR_IF(new_n > (static_cast<size_type>(-1) - huge_page_size) / sizeof(T),
+                              "huge_page_allocator<T>::reallocate(n) too big");
+        const size_type old_size = map_size(old_n);
+        const size_type new_size = map_size(new_n);
+        if (old_size == new_size)
+            return ptr;
+        void *result = ::mremap(ptr, old_size, new_size, MREMAP_MAYMOVE);
+        if (result == MAP_FAILED)
+            throw std::bad_alloc();
+        if (new_size > old_size)
+        {
+#ifdef MADV_HUGEPAGE
+            ::madvise(result, new_size, MADV_HUGEPAGE);
+#endif
+            if (Populate)
+            {
+                volatile char *p = static_cast<char *>(result);
+                for (size_type i = old_size; i < new_size; i += 4096)
+                    p[i] = 0;
+            }
+        }
+        return static_cast<pointer>(result);
+#else
+        (void)ptr;
+        (void)old_n;
+        (void)new_n;
+        return nullptr;
+#endif
+    }
+
+    template <class T, class U, size_t Threshold, bool Populate>
+    bool operator==(const huge_page_allocator<T, Threshold, Populate> &,
+                    const huge_page_allocator<U, Threshold, Populate> &) noexcept
+    {
+        return true;
+    }
+    template <class T, class U, size_t Threshold, bool Populate>
+    bool operator!=(const huge_page_allocator<T, Threshold, Populate> &,
+                    const huge_page_allocator<U, Threshold, Populate> &) noexcept
+    {
+        return false;
+    }
+} // namespace mystl
+#endif // !MYTINYSTL_HUGE_PAGE_ALLOCATOR_H_
@@ -0,0 +1,330 @@
+#ifndef MYTINYSTL_INSTRUMENTED_ALLOCATOR_H_
+#define MYTINYSTL_INSTRUMENTED_ALLOCATOR_H_
+
+// 这个头文件包含分配统计 alloc_stats 与包装配置器 instrumented_allocator
+// instrumented_allocator<T, Tag, Alloc> 把请求转发给 Alloc，同时在 Tag 对应的 alloc_stats 上记录：
+// 当前占用字节、峰值字节、分配/释放次数，以及按 2 的幂分桶的请求大小直方图
+// Tag 为 void 时按类型 T 统计（list 统计的是结点类型），否则同一个 Tag 的所有容器合并统计
+// allocate_at_least 按实际得到的大小统计；Alloc 提供 reallocate 时同样转发并记录大小的变化，
+// 开启统计不会改变容器的扩容行为
+// 可以用 alloc_stats::snapshot_all() 取得快照，或用 alloc_stats::dump_json() 输出 JSON
+//
+// 只有定义了宏 MYSTL_ALLOC_TELEMETRY 时才统计，否则 instrumented_allocator 就是 Alloc 本身，
+// 容器类型与不使用包装时完全相同，没有任何开销
+
+#include <atomic>
+#include <cstddef>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
+
+#include "allocator.h"
+#include "allocator_traits.h"
+
+namespace mystl
+{
+    // 某一组统计在某一时刻的快照
+    struct alloc_stats_snapshot
+    {
+        static constexpr size_t bucket_count = 20; // 直方图桶数：<=8, <=16, ..., <=2MB, 更大
+
+        const char *name;
+        size_t live_bytes;
+        size_t peak_bytes;
+        size_t alloc_count;
+        size_t dealloc_count;
+        size_t histogram[bucket_count];
+
+        // 第 i 个桶的上界（字节），最后一个桶没有上界
+        static size_t bucket_limit(size_t i) noexcept { return size_t(8) << i; }
+    };
+
+    // --------------------------------------------------------------------------------------
+    // 类：alloc_stats
+    // 一个统计对象对应一个类型或一个 Tag，所有统计对象串在一个全局链表上以便导出
+    class alloc_stats
+    {
+    public:
+        static constexpr size_t bucket_count = alloc_stats_snapshot::bucket_count;
+
+    private:
+        const char *name_;
+        std::atomic<size_t> live_{0};
+        std::atomic<size_t> peak_{0};
+        std::atomic<size_t> alloc_count_{0};
+        std::atomic<size_t> dealloc_count_{0};
+        std::atomic<size_t> histogram_[bucket_count] = {};
+        alloc_stats *next_; // 全局链表中的下一个
+
+        inline static std::atomic<alloc_stats *> head_{nullptr};
+
+    public:
+        explicit alloc_stats(const char *name) noexcept
+            : name_(name), next_(head_.load(std::memory_order_relaxed))
+        {
+            // 只会插入不会删除，用 CAS 压到链表头部即可
+            while (!head_.compare_exchange_weak(next_, this, std::memory_order_release,
+                                                std::memory_order_relaxed))
+            {
+            }
+        }
+        alloc_stats(const alloc_stats &) = delete;
+        alloc_stats &operator=(const alloc_stats &) = delete;
+
+        void record_allocate(size_t bytes) noexcept
+        {
+            const size_t live = live_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+            size_t peak = peak_.load(std::memory_order_relaxed);
+            while (live > peak &&
+                   !peak_.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+            {
+            }
+            alloc_count_.fetch_add(1, std::memory_order_relaxed);
+            histogram_[bucket_of(bytes)].fetch_add(1, std::memory_order_relaxed);
+        }
+        void record_deallocate(size_t bytes) noexcept
+        {
+            live_.fetch_sub(bytes, std::memory_order_relaxed);
+            dealloc_count_.fetch_add(1, std::memory_order_relaxed);
+        }
+        // 区块原地改变大小（reallocate），分配与释放次数不变
+        void record_reallocate(size_t old_bytes, size_t new_bytes) noexcept
+        {
+            if (new_bytes < old_bytes)
+            {
+                live_.fetch_sub(old_bytes - new_bytes, std::memory_order_relaxed);
+                return;
+            }
+            const size_t grow = new_bytes - old_bytes;
+            const size_t live = live_.fetch_add(grow, std::memory_order_relaxed) + grow;
+            size_t peak = peak_.load(std::memory_order_relaxed);
+            while (live > peak &&
+                   !peak_.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        const char *name() const noexcept { return name_; }
+        alloc_stats_snapshot snapshot() const noexcept;
+
+        // 所有统计对象的快照与 JSON 导出
+        static std::vector<alloc_stats_snapshot> snapshot_all();
+        static void dump_json(std::ostream &os);
+        static std::string to_json()
+        {
+            std::ostringstream os;
+            dump_json(os);
+            return os.str();
+        }
+
+        // 请求大小所在的桶
+        static size_t bucket_of(size_t bytes) noexcept
+        {
+            size_t i = 0;
+            while (i + 1 < bucket_count && alloc_stats_snapshot::bucket_limit(i) < bytes)
+                ++i;
+            return i;
+        }
+    };
+
+    inline alloc_stats_snapshot alloc_stats::snapshot() const noexcept
+    {
+        alloc_stats_snapshot s;
+        s.name = name_;
+        s.live_bytes = live_.load(std::memory_order_relaxed);
+        s.peak_bytes = peak_.load(std::memory_order_relaxed);
+        s.alloc_count = alloc_count_.load(std::memory_order_relaxed);
+        s.dealloc_count = dealloc_count_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < bucket_count; ++i)
+            s.histogram[i] = histogram_[i].load(std::memory_order_relaxed);
+        return s;
+    }
+
+    inline std::vector<alloc_stats_snapshot> alloc_stats::snapshot_all()
+    {
+        std::vector<alloc_stats_snapshot> result;
+        for (alloc_stats *p = head_.load(std::memory_order_acquire); p != nullptr; p = p->next_)
+            result.push_back(p->snapshot());
+        return result;
+    }
+
+    // 输出形如 [{"name":"int","live_bytes":0,...,"histogram":{"8":1,...}}, ...] 的 JSON
+    inline void alloc_stats::dump_json(std::ostream &os)
+    {
+        os << '[';
+        bool first = true;
+        for (const auto &s : snapshot_all())
+        {
+            if (!first)
+                os << ',';
+            first = false;
+            os << "{\"name\":\"";
+            for (const char *c = s.name; *c != '\0'; ++c)
+            {
+                if (*c == '"' || *c == '\\')
+                    os << '\\';
+                os << *c;
+            }
+            os << "\",\"live_bytes\":" << s.live_bytes
+               << ",\"peak_bytes\":" << s.peak_bytes
+               << ",\"alloc_count\":" << s.alloc_count
+               << ",\"dealloc_count\":" << s.dealloc_count
+               << ",\"histogram\":{";
+            bool first_bucket = true;
+            for (size_t i = 0; i < bucket_count; ++i)
+            {
+                if (s.histogram[i] == 0)
+                    continue;
+                if (!first_bucket)
+                    os << ',';
+                first_bucket = false;
+                if (i + 1 == bucket_count)
+                    os << "\"inf\":";
+                else
+                    os << '"' << alloc_stats_snapshot::bucket_limit(i) << "\":";
+                os << s.histogram[i];
+            }
+            os << "}}";
+        }
+        os << ']';
+    }
+
+    // 取得 Key 对应的统计对象，Key 定义了 static 成员 name 时用它作名字，否则用 typeid 的名字
+    template <class Key, class = void>
+    struct alloc_stats_name
+    {
+        static const char *get() noexcept
+        {
+#ifdef __GNUG__
+            // 每个类型只还原一次，得到的字符串与统计对象一样一直存在
+            int status = 0;
+            char *demangled = abi::__cxa_demangle(typeid(Key).name(), nullptr, nullptr, &status);
+            if (demangled != nullptr)
+                return demangled;
+#endif
+            return typeid(Key).name();
+        }
+    };
+    template <class Key>
+    struct alloc_stats_name<Key, std::void_t<decltype(Key::name)>>
+    {
+        static const char *get() noexcept { return Key::name; }
+    };
+
+    template <class Key>
+    alloc_stats &alloc_stats_of()
+    {
+        static alloc_stats stats(alloc_stats_name<Key>::get());
+        return stats;
+    }
+
+#ifdef MYSTL_ALLOC_TELEMETRY
+    // --------------------------------------------------------------------------------------
+    // 模板类：instrumented_allocator
+    template <class T, class Tag = void, class Alloc = mystl::allocator<T>>
+    class instrumented_allocator : private mystl::allocator_holder<Alloc>
+    {
+    private:
+        typedef mystl::allocator_holder<Alloc> alloc_base;
+        typedef mystl::allocator_traits<Alloc> base_traits;
+        // 统计的键：Tag 为 void 时按类型统计
+        typedef typename std::conditional<std::is_void<Tag>::value, T, Tag>::type key_type;
+
+    public:
+        typedef T value_type;
+        typedef T *pointer;
+        typedef const T *const_pointer;
+        typedef T &reference;
+        typedef const T &const_reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        template <class U>
+        struct rebind
+        {
+            typedef instrumented_allocator<U, Tag, typename base_traits::template rebind_alloc<U>> other;
+        };
+
+        typedef typename base_traits::propagate_on_container_copy_assignment
+            propagate_on_container_copy_assignment;
+        typedef typename base_traits::propagate_on_container_move_assignment
+            propagate_on_container_move_assignment;
+        typedef typename base_traits::propagate_on_container_swap propagate_on_container_swap;
+        typedef typename base_traits::is_always_equal is_always_equal;
+
+    public:
+        instrumented_allocator() = default;
+        instrumented_allocator(const Alloc &a) : alloc_base(a) {}
+        template <class U, class A>
+        instrumented_allocator(const instrumented_allocator<U, Tag, A> &other)
+            : alloc_base(Alloc(other.base()))
+        {
+        }
+
+        pointer allocate(size_type n)
+        {
+            pointer p = base_traits::allocate(this->get(), n);
+            alloc_stats_of<key_type>().record_allocate(n * sizeof(T));
+            return p;
+        }
+        // Alloc 多给的空间也计入统计，容器释放时传回的个数就是 block.count
+        allocation_result<pointer, size_type> allocate_at_least(size_type n)
+        {
+            const auto block = base_traits::allocate_at_least(this->get(), n);
+            alloc_stats_of<key_type>().record_allocate(block.count * sizeof(T));
+            return {block.ptr, block.count};
+        }
+        void deallocate(pointer ptr, size_type n)
+        {
+            if (ptr == nullptr)
+                return;
+            alloc_stats_of<key_type>().record_deallocate(n * sizeof(T));
+            base_traits::deallocate(this->get(), ptr, n);
+        }
+        // 只在 Alloc 提供 reallocate 时存在，has_reallocate 的结果与 Alloc 相同
+        template <class A = Alloc, typename std::enable_if<mystl::has_reallocate<A>::value, int>::type = 0>
+        pointer reallocate(pointer ptr, size_type old_n, size_type new_n)
+        {
+            pointer p = base_traits::reallocate(this->get(), ptr, old_n, new_n);
+            if (p != nullptr)
+                alloc_stats_of<key_type>().record_reallocate(old_n * sizeof(T), new_n * sizeof(T));
+            return p;
+        }
+
+        instrumented_allocator select_on_container_copy_construction() const
+        {
+            return instrumented_allocator(base_traits::select_on_container_copy_construction(base()));
+        }
+
+        const Alloc &base() const noexcept { return this->get(); }
+
+        // 当前类型（或 Tag）的统计
+        static alloc_stats &stats() { return alloc_stats_of<key_type>(); }
+    };
+
+    template <class T, class U, class Tag, class A1, class A2>
+    bool operator==(const instrumented_allocator<T, Tag, A1> &lhs,
+                    const instrumented_allocator<U, Tag, A2> &rhs)
+    {
+        return lhs.base() == rhs.base();
+    }
+    template <class T, class U, class Tag, class A1, class A2>
+    bool operator!=(const instrumented_allocator<T, Tag, A1> &lhs,
+                    const instrumented_allocator<U, Tag, A2> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+#else
+    // 未开启统计时就是被包装的配置器本身
+    template <class T, class Tag = void, class Alloc = mystl::allocator<T>>
+    using instrumented_allocator = Alloc;
+#endif
+} // namespace mystl
+#endif // !MYTINYSTL_INSTRUMENTED_ALLOCATOR_H_
@@ -11,6 +11,7 @@
 #include "algobase.h"
 #include "allocator.h"
 #include "construct.h"
+#include "scratch_arena.h"
 #include "uninitialized.h"
 
 namespace mystl
@@ -25,19 +26,14 @@ namespace mystl
 
     // 获取 / 释放 临时缓冲区
 
+    // 临时缓冲区来自当前线程的 scratch_arena，放不下时才使用 malloc
     template <class T>
     pair<T *, ptrdiff_t> get_buffer_helper(ptrdiff_t len, T *)
     {
         if (len > static_cast<ptrdiff_t>(INT_MAX / sizeof(T)))
             len = INT_MAX / sizeof(T);
-        while (len > 0)
-        {
-            T *tmp = static_cast<T *>(malloc(static_cast<size_t>(len) * sizeof(T)));
-            if (tmp)
-                return pair<T *, ptrdiff_t>(tmp, len);
-            len /= 2; // 申请失败时减少 len 的大小
-        }
-        return pair<T *, ptrdiff_t>(nullptr, 0);
+        T *tmp = static_cast<T *>(scratch_arena::local().allocate(len, sizeof(T), alignof(T)));
+        return pair<T *, ptrdiff_t>(tmp, len);
     }
 
     template <class T>
@@ -52,10 +48,11 @@ namespace mystl
         return get_buffer_helper(len, static_cast<T *>(0));
     }
 
+    // 按申请的相反顺序释放时空间立即收回，否则要等后申请的缓冲区都释放后才收回
     template <class T>
     void release_temporary_buffer(T *ptr)
     {
-        free(ptr);
+        scratch_arena::local().deallocate(ptr, alignof(T));
     }
 
     // --------------------------------------------------------------------------------------
@@ -76,7 +73,7 @@ namespace mystl
         ~temporary_buffer()
         {
             mystl::destroy(buffer, buffer + len);
-            free(buffer);
+            mystl::release_temporary_buffer(buffer);
         }
 
     public:
@@ -114,7 +111,7 @@ namespace mystl
         }
         catch (...)
         {
-            free(buffer);
+            mystl::release_temporary_buffer(buffer);
             buffer = nullptr;
             len = 0;
         }
@@ -125,15 +122,9 @@ namespace mystl
     void temporary_buffer<ForwardIterator, T>::allocate_buffer()
     {
         original_len = len;
-        if (len > static_cast<ptrdiff_t>(INT_MAX / sizeof(T)))
-            len = INT_MAX / sizeof(T);
-        while (len > 0)
-        {
-            buffer = static_cast<T *>(malloc(len * sizeof(T)));
-            if (buffer)
-                break;
-            len /= 2; // 申请失败时减少申请空间大小
-        }
+        auto result = mystl::get_temporary_buffer<T>(len);
+        buffer = result.first;
+        len = result.second;
     }
 
     // --------------------------------------------------------------------------------------
@@ -204,5 +195,11 @@ namespace mystl
         }
     };
 
+    // auto_ptr 只保存一个指针，可以按字节搬移
+    template <class T>
+    struct is_trivially_relocatable<auto_ptr<T>> : std::true_type
+    {
+    };
+
 } // namespace mystl
 #endif // !MYTINYSTL_MEMORY_H_
@@ -0,0 +1,306 @@
+#ifndef MYTINYSTL_MEMORY_RESOURCE_H_
+#define MYTINYSTL_MEMORY_RESOURCE_H_
+
+// 这个头文件包含多态内存资源 memory_resource 及相关的类，均位于 mystl::pmr 中
+// memory_resource           : 内存资源的抽象基类
+// new_delete_resource()     : 使用 ::operator new / ::operator delete 的内存资源
+// monotonic_buffer_resource : 单调增长的内存池，指针递增分配，释放为空操作，release() 一次性归还
+// polymorphic_allocator<T>  : 持有 memory_resource 指针的配置器，供 pmr::vector 等容器使用
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+#include "exceptdef.h"
+
+namespace mystl
+{
+    namespace pmr
+    {
+        // 默认的对齐大小
+        constexpr size_t max_align = alignof(std::max_align_t);
+
+        // 抽象基类：memory_resource
+        class memory_resource
+        {
+        public:
+            virtual ~memory_resource() = default;
+
+            void *allocate(size_t bytes, size_t alignment = max_align)
+            {
+                return do_allocate(bytes, alignment);
+            }
+            void deallocate(void *ptr, size_t bytes, size_t alignment = max_align)
+            {
+                do_deallocate(ptr, bytes, alignment);
+            }
+            bool is_equal(const memory_resource &other) const noexcept
+            {
+                return do_is_equal(other);
+            }
+
+        private:
+            virtual void *do_allocate(size_t bytes, size_t alignment) = 0;
+            virtual void do_deallocate(void *ptr, size_t bytes, size_t alignment) = 0;
+            virtual bool do_is_equal(const memory_resource &other) const noexcept = 0;
+        };
+
+        inline bool operator==(const memory_resource &lhs, const memory_resource &rhs) noexcept
+        {
+            return &lhs == &rhs || lhs.is_equal(rhs);
+        }
+        inline bool operator!=(const memory_resource &lhs, const memory_resource &rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+        // --------------------------------------------------------------------------------------
+        // 使用 ::operator new / ::operator delete 的内存资源
+        class new_delete_memory_resource : public memory_resource
+        {
+        private:
+            void *do_allocate(size_t bytes, size_t alignment) override
+            {
+                if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+                    return ::operator new(bytes, std::align_val_t(alignment));
+                return ::operator new(bytes);
+            }
+            void do_deallocate(void *ptr, size_t bytes, size_t alignment) override
+            {
+                if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+                    ::operator delete(ptr, bytes, std::align_val_t(alignment));
+                else
+                    ::operator delete(ptr, bytes);
+            }
+            bool do_is_equal(const memory_resource &other) const noexcept override
+            {
+                return this == &other;
+            }
+        };
+
+        inline memory_resource *new_delete_resource() noexcept
+        {
+            static new_delete_memory_resource resource;
+            return &resource;
+        }
+
+        // 默认内存资源，未指定时 polymorphic_allocator 使用它
+        inline std::atomic<memory_resource *> &default_resource() noexcept
+        {
+            static std::atomic<memory_resource *> resource(new_delete_resource());
+            return resource;
+        }
+        inline memory_resource *get_default_resource() noexcept
+        {
+            return default_resource().load(std::memory_order_acquire);
+        }
+        // 设置默认内存资源，传入 nullptr 时恢复为 new_delete_resource()，返回原来的资源
+        inline memory_resource *set_default_resource(memory_resource *r) noexcept
+        {
+            if (r == nullptr)
+                r = new_delete_resource();
+            return default_resource().exchange(r, std::memory_order_acq_rel);
+        }
+
+        // --------------------------------------------------------------------------------------
+        // 类：monotonic_buffer_resource
+        // 从当前块中递增指针分配，块用完时向上游申请一个更大的块
+        // deallocate 什么都不做，所有内存在 release() 或析构时一起归还给上游
+        // 不是线程安全的，适合一个请求内的临时容器
+        class monotonic_buffer_resource : public memory_resource
+        {
+        private:
+            // 向上游申请的块的头部，块之间组成单链表
+            struct chunk_header
+            {
+                chunk_header *next;
+                size_t size;
+                size_t alignment;
+            };
+
+            static constexpr size_t default_next_size = 1024; // 第一次向上游申请的块大小
+            static constexpr size_t growth_factor = 2;        // 之后每次块大小的增长倍数
+
+        private:
+            memory_resource *upstream_;
+            void *initial_buffer_;    // 用户提供的初始缓冲区
+            size_t initial_size_;     // 初始缓冲区的大小
+            char *cur_;               // 当前块中可分配的位置
+            size_t space_;            // 当前块剩余的大小
+            size_t next_size_;        // 下一次向上游申请的块大小
+            chunk_header *chunks_;    // 已向上游申请的块
+
+        public:
+            explicit monotonic_buffer_resource(memory_resource *upstream = get_default_resource())
+                : monotonic_buffer_resource(nullptr, 0, default_next_size, upstream)
+            {
+            }
+            monotonic_buffer_resource(size_t initial_size,
+                                      memory_resource *upstream = get_default_resource())
+                : monotonic_buffer_resource(nullptr, 0, initial_size, upstream)
+            {
+            }
+            monotonic_buffer_resource(void *buffer, size_t buffer_size,
+                                      memory_resource *upstream = get_default_resource())
+                : monotonic_buffer_resource(buffer, buffer_size,
+                                            buffer_size * growth_factor, upstream)
+            {
+            }
+
+            monotonic_buffer_resource(const monotonic_buffer_resource &) = delete;
+            monotonic_buffer_resource &operator=(const monotonic_buffer_resource &) = delete;
+
+            ~monotonic_buffer_resource() override
+            {
+                release();
+            }
+
+            // 把所有块归还给上游，重新从初始缓冲区开始分配
+            void release() noexcept
+            {
+                while (chunks_ != nullptr)
+                {
+                    chunk_header *next = chunks_->next;
+                    upstream_->deallocate(chunks_, chunks_->size, chunks_->alignment);
+                    chunks_ = next;
+                }
+                cur_ = static_cast<char *>(initial_buffer_);
+                space_ = initial_size_;
+            }
+
+            memory_resource *upstream_resource() const noexcept { return upstream_; }
+
+        private:
+            monotonic_buffer_resource(void *buffer, size_t buffer_size, size_t next_size,
+                                      memory_resource *upstream)
+                : upstream_(upstream), initial_buffer_(buffer), initial_size_(buffer_size),
+                  cur_(static_cast<char *>(buffer)), space_(buffer_size),
+                  next_size_(next_size < sizeof(chunk_header) * 2 ? default_next_size : next_size),
+                  chunks_(nullptr)
+            {
+            }
+
+            // 在当前块中对齐并切出 bytes 大小的空间，空间不足时返回 nullptr
+            void *bump(size_t bytes, size_t alignment) noexcept
+            {
+                const size_t addr = reinterpret_cast<size_t>(cur_);
+                const size_t pad = (alignment - addr % alignment) % alignment;
+                if (cur_ == nullptr || space_ < pad || space_ - pad < bytes)
+                    return nullptr;
+                char *result = cur_ + pad;
+                cur_ = result + bytes;
+                space_ -= pad + bytes;
+                return result;
+            }
+
+            void *do_allocate(size_t bytes, size_t alignment) override
+            {
+                if (bytes == 0)
+                    bytes = 1;
+                void *result = bump(bytes, alignment);
+                if (result != nullptr)
+                    return result;
+
+                // 当前块不够，申请一个新块：至少能放下头部、对齐填充和这次的请求
+                const size_t header = (sizeof(chunk_header) + alignment - 1) / alignment * alignment;
+                size_t chunk_size = next_size_;
+                if (chunk_size < header + bytes)
+                    chunk_size = header + bytes;
+                const size_t chunk_align = alignment < alignof(chunk_header) ? alignof(chunk_header)
+                                                                            : alignment;
+                void *raw = upstream_->allocate(chunk_size, chunk_align);
+                chunk_header *h = static_cast<chunk_header *>(raw);
+                h->next = chunks_;
+                h->size = chunk_size;
+                h->alignment = chunk_align;
+                chunks_ = h;
+                cur_ = static_cast<char *>(raw) + header;
+                space_ = chunk_size - header;
+                if (next_size_ <= static_cast<size_t>(-1) / growth_factor)
+                    next_size_ *= growth_factor;
+                return bump(bytes, alignment);
+            }
+            void do_deallocate(void *, size_t, size_t) override
+            {
+            }
+            bool do_is_equal(const memory_resource &other) const noexcept override
+            {
+                return this == &other;
+            }
+        };
+
+        // --------------------------------------------------------------------------------------
+        // 模板类：polymorphic_allocator
+        // 把分配请求转发给 memory_resource，容器不需要知道内存从哪里来
+        template <class T>
+        class polymorphic_allocator
+        {
+        public:
+            typedef T value_type;
+            typedef T *pointer;
+            typedef const T *const_pointer;
+            typedef T &reference;
+            typedef const T &const_reference;
+            typedef size_t size_type;
+            typedef ptrdiff_t difference_type;
+
+            template <class U>
+            struct rebind
+            {
+                typedef polymorphic_allocator<U> other;
+            };
+
+        private:
+            memory_resource *resource_;
+
+        public:
+            polymorphic_allocator() noexcept : resource_(get_default_resource()) {}
+            polymorphic_allocator(memory_resource *r) noexcept
+                : resource_(r == nullptr ? get_default_resource() : r)
+            {
+            }
+            polymorphic_allocator(const polymorphic_allocator &) = default;
+            template <class U>
+            polymorphic_allocator(const polymorphic_allocator<U> &other) noexcept
+                : resource_(other.resource())
+            {
+            }
+            polymorphic_allocator &operator=(const polymorphic_allocator &) = delete;
+
+            pointer allocate(size_type n)
+            {
+                THROW_LENGTH_ERROR_IF(n > static_cast<size_type>(-1) / sizeof(T),
+                                      "polymorphic_allocator<T>::allocate(n) too big");
+                return static_cast<pointer>(resource_->allocate(n * sizeof(T), alignof(T)));
+            }
+            void deallocate(pointer ptr, size_type n)
+            {
+                if (ptr == nullptr)
+                    return;
+                resource_->deallocate(ptr, n * sizeof(T), alignof(T));
+            }
+
+            memory_resource *resource() const noexcept { return resource_; }
+
+            // 复制构造容器时不沿用原来的内存资源，而是使用默认资源
+            polymorphic_allocator select_on_container_copy_construction() const noexcept
+            {
+                return polymorphic_allocator();
+            }
+        };
+
+        template <class T, class U>
+        bool operator==(const polymorphic_allocator<T> &lhs,
+                        const polymorphic_allocator<U> &rhs) noexcept
+        {
+            return *lhs.resource() == *rhs.resource();
+        }
+        template <class T, class U>
+        bool operator!=(const polymorphic_allocator<T> &lhs,
+                        const polymorphic_allocator<U> &rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+    } // namespace pmr
+} // namespace mystl
+#endif // !MYTINYSTL_MEMORY_RESOURCE_H_
@@ -0,0 +1,212 @@
+#ifndef MYTINYSTL_OBJECT_POOL_H_
+#define MYTINYSTL_OBJECT_POOL_H_
+
+// 这个头文件包含模板类 object_pool 与 thread_object_pool，用于构造代价高的对象
+// object_pool        : release 时对象不析构，执行 Reset 后放回缓存，下次 acquire 直接取出，
+//                      对象内部已经申请的空间（例如 reserve 过的 vector、string）得以保留；
+//                      缓存是容量固定的指针栈，acquire / release 都是 O(1)，
+//                      缓存满了才真正析构释放；Reset 在 release 时调用，不能抛出异常
+// thread_object_pool : 每个线程一个 object_pool，不需要加锁，
+//                      对象可以在其他线程 release，此时放入那个线程的缓存
+//   例：struct clear_buffer { void operator()(mystl::string &s) const { s.clear(); } };
+//       mystl::object_pool<mystl::string, clear_buffer> pool(64);
+//       mystl::string *s = pool.acquire();
+//       ...
+//       pool.release(s);
+// object_pool 不是线程安全的；仍被取出的对象要在 object_pool 析构前 release
+
+#include <cstddef>
+#include <new>
+
+#include "allocator.h"
+#include "construct.h"
+#include "destroy.h"
+#include "util.h"
+
+namespace mystl
+{
+    // 默认的 Reset：对象原样放回
+    struct object_pool_no_reset
+    {
+        template <class T>
+        void operator()(T &) const noexcept {}
+    };
+
+    template <class T, class Reset = object_pool_no_reset>
+    class object_pool
+    {
+    public:
+        typedef T value_type;
+        typedef size_t size_type;
+
+        static constexpr size_type default_capacity = 64; // 默认最多缓存的对象个数
+
+        // RAII 的句柄，析构时把对象还给 object_pool
+        class handle
+        {
+        private:
+            object_pool *pool_;
+            T *obj_;
+
+        public:
+            handle() noexcept : pool_(nullptr), obj_(nullptr) {}
+            handle(object_pool *pool, T *obj) noexcept : pool_(pool), obj_(obj) {}
+            handle(handle &&rhs) noexcept : pool_(rhs.pool_), obj_(rhs.obj_) { rhs.obj_ = nullptr; }
+            handle &operator=(handle &&rhs) noexcept
+            {
+                if (this != &rhs)
+                {
+                    reset();
+                    pool_ = rhs.pool_;
+                    obj_ = rhs.obj_;
+                    rhs.obj_ = nullptr;
+                }
+                return *this;
+            }
+            handle(const handle &) = delete;
+            handle &operator=(const handle &) = delete;
+            ~handle() { reset(); }
+
+            T *get() const noexcept { return obj_; }
+            T &operator*() const noexcept { return *obj_; }
+            T *operator->() const noexcept { return obj_; }
+            explicit operator bool() const noexcept { return obj_ != nullptr; }
+
+            void reset() noexcept
+            {
+                if (obj_ != nullptr)
+                    pool_->release(obj_);
+                obj_ = nullptr;
+            }
+        };
+
+    private:
+        T **cache_;          // 已构造、空闲的对象
+        size_type size_;     // 缓存中的对象个数
+        size_type capacity_; // 缓存的上限
+        Reset reset_;
+
+    public:
+        explicit object_pool(size_type capacity = default_capacity, const Reset &reset = Reset())
+            : cache_(mystl::allocator<T *>::allocate(capacity)), size_(0), capacity_(capacity),
+              reset_(reset)
+        {
+        }
+        object_pool(const object_pool &) = delete;
+        object_pool &operator=(const object_pool &) = delete;
+        ~object_pool()
+        {
+            clear();
+            mystl::allocator<T *>::deallocate(cache_, capacity_);
+        }
+
+        // 取出一个对象：缓存中有就直接返回，参数被忽略；否则用 args 构造一个新对象
+        template <class... Args>
+        T *acquire(Args &&...args)
+        {
+            if (size_ != 0)
+                return cache_[--size_];
+            T *obj = mystl::allocator<T>::allocate(1);
+            try
+            {
+                mystl::construct(obj, mystl::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                mystl::allocator<T>::deallocate(obj, 1);
+                throw;
+            }
+            return obj;
+        }
+        template <class... Args>
+        handle acquire_handle(Args &&...args)
+        {
+            return handle(this, acquire(mystl::forward<Args>(args)...));
+        }
+
+        // 归还对象：执行 Reset 后放回缓存，缓存已满时析构释放
+        void release(T *obj) noexcept
+        {
+            if (obj == nullptr)
+                return;
+            if (size_ == capacity_)
+            {
+                destroy_object(obj);
+                return;
+            }
+            reset_(*obj);
+            cache_[size_++] = obj;
+        }
+
+        // 预先构造 n 个对象放入缓存
+        template <class... Args>
+        void prefill(size_type n, const Args &...args)
+        {
+            while (size_ < capacity_ && n-- > 0)
+            {
+                T *obj = mystl::allocator<T>::allocate(1);
+                try
+                {
+                    mystl::construct(obj, args...);
+                }
+                catch (...)
+                {
+                    mystl::allocator<T>::deallocate(obj, 1);
+                    throw;
+                }
+                cache_[size_++] = obj;
+            }
+        }
+        // 析构并释放缓存中的全部对象
+        void clear() noexcept
+        {
+            while (size_ != 0)
+                destroy_object(cache_[--size_]);
+        }
+
+        size_type cached() const noexcept { return size_; }
+        size_type capacity() const noexcept { return capacity_; }
+
+    private:
+        static void destroy_object(T *obj) noexcept
+        {
+            mystl::destroy(obj);
+            mystl::allocator<T>::deallocate(obj, 1);
+        }
+    };
+
+    // --------------------------------------------------------------------------------------
+    // 模板类：thread_object_pool
+    // 每个线程第一次使用时建立自己的 object_pool，线程退出时析构其中缓存的对象
+    // handle 记住的是取出时所在线程的 object_pool，只能在同一个线程析构
+    template <class T, class Reset = object_pool_no_reset,
+              size_t Capacity = object_pool<T, Reset>::default_capacity>
+    class thread_object_pool
+    {
+    public:
+        typedef object_pool<T, Reset> pool_type;
+        typedef typename pool_type::handle handle;
+
+        static pool_type &local()
+        {
+            thread_local pool_type pool(Capacity);
+            return pool;
+        }
+
+        template <class... Args>
+        static T *acquire(Args &&...args)
+        {
+            return local().acquire(mystl::forward<Args>(args)...);
+        }
+        template <class... Args>
+        static handle acquire_handle(Args &&...args)
+        {
+            return local().acquire_handle(mystl::forward<Args>(args)...);
+        }
+        static void release(T *obj) noexcept
+        {
+            local().release(obj);
+        }
+    };
+} // namespace mystl
+#endif // !MYTINYSTL_OBJECT_POOL_H_
@@ -0,0 +1,143 @@
+#ifndef MYTINYSTL_OFFSET_PTR_H_
+#define MYTINYSTL_OFFSET_PTR_H_
+
+// 这个头文件包含模板类 offset_ptr，保存目标地址相对于自身地址的偏移
+// 只要 offset_ptr 与它指向的对象位于同一块内存中，这块内存被映射到任何地址都仍然有效，
+// 因此可以作为共享内存配置器的 pointer，让容器在另一个进程中直接读取
+// offset_ptr 可以隐式地与 T* 互相转换，比较、相减、下标等操作都通过原生指针完成
+// 注意：偏移依赖于 offset_ptr 自身的地址，复制时会重新计算，不能用 memcpy 复制
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace mystl
+{
+    template <class T>
+    class offset_ptr
+    {
+    public:
+        typedef T element_type;
+        typedef T *pointer;
+        typedef ptrdiff_t difference_type;
+
+        template <class U>
+        using rebind = offset_ptr<U>;
+
+    private:
+        // 偏移为 1 表示空指针：对象不可能指向自身地址加一的位置
+        static constexpr ptrdiff_t null_offset = 1;
+
+        ptrdiff_t offset_;
+
+    public:
+        offset_ptr() noexcept : offset_(null_offset) {}
+        offset_ptr(T *p) noexcept : offset_(to_offset(p)) {}
+        offset_ptr(const offset_ptr &rhs) noexcept : offset_(to_offset(rhs.get())) {}
+        template <class U, typename std::enable_if<std::is_convertible<U *, T *>::value, int>::type = 0>
+        offset_ptr(const offset_ptr<U> &rhs) noexcept : offset_(to_offset(rhs.get())) {}
+
+        offset_ptr &operator=(const offset_ptr &rhs) noexcept
+        {
+            offset_ = to_offset(rhs.get());
+            return *this;
+        }
+        offset_ptr &operator=(T *p) noexcept
+        {
+            offset_ = to_offset(p);
+            return *this;
+        }
+
+        T *get() const noexcept
+        {
+            if (offset_ == null_offset)
+                return nullptr;
+            return reinterpret_cast<T *>(reinterpret_cast<uintptr_t>(this) + offset_);
+        }
+        operator T *() const noexcept { return get(); }
+        T *operator->() const noexcept { return get(); }
+
+        offset_ptr &operator++() noexcept { return *this = get() + 1; }
+        offset_ptr &operator--() noexcept { return *this = get() - 1; }
+        offset_ptr operator++(int) noexcept
+        {
+            T *tmp = get();
+            *this = tmp + 1;
+            return tmp;
+        }
+        offset_ptr operator--(int) noexcept
+        {
+            T *tmp = get();
+            *this = tmp - 1;
+            return tmp;
+        }
+        offset_ptr &operator+=(difference_type n) noexcept { return *this = get() + n; }
+        offset_ptr &operator-=(difference_type n) noexcept { return *this = get() - n; }
+
+        static offset_ptr pointer_to(T &r) noexcept { return offset_ptr(&r); }
+
+    private:
+        ptrdiff_t to_offset(const void *p) const noexcept
+        {
+            if (p == nullptr)
+                return null_offset;
+            return static_cast<ptrdiff_t>(reinterpret_cast<uintptr_t>(p) -
+                                          reinterpret_cast<uintptr_t>(this));
+        }
+    };
+
+    // void 没有引用，也不能做指针运算
+    template <>
+    class offset_ptr<void>
+    {
+    public:
+        typedef void element_type;
+        typedef void *pointer;
+        typedef ptrdiff_t difference_type;
+
+        template <class U>
+        using rebind = offset_ptr<U>;
+
+    private:
+        static constexpr ptrdiff_t null_offset = 1;
+
+        ptrdiff_t offset_;
+
+    public:
+        offset_ptr() noexcept : offset_(null_offset) {}
+        offset_ptr(void *p) noexcept : offset_(to_offset(p)) {}
+        offset_ptr(const offset_ptr &rhs) noexcept : offset_(to_offset(rhs.get())) {}
+        template <class U>
+        offset_ptr(const offset_ptr<U> &rhs) noexcept : offset_(to_offset(rhs.get())) {}
+
+        offset_ptr &operator=(const offset_ptr &rhs) noexcept
+        {
+            offset_ = to_offset(rhs.get());
+            return *this;
+        }
+        offset_ptr &operator=(void *p) noexcept
+        {
+            offset_ = to_offset(p);
+            return *this;
+        }
+
+        void *get() const noexcept
+        {
+            if (offset_ == null_offset)
+                return nullptr;
+            return reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(this) + offset_);
+        }
+        operator void *() const noexcept { return get(); }
+        void *operator->() const noexcept { return get(); }
+
+    private:
+        ptrdiff_t to_offset(const void *p) const noexcept
+        {
+            if (p == nullptr)
+                return null_offset;
+            return static_cast<ptrdiff_t>(reinterpret_cast<uintptr_t>(p) -
+                                          reinterpret_cast<uintptr_t>(this));
+        }
+    };
+} // namespace mystl
+#endif // !MYTINYSTL_OFFSET_PTR_H_
@@ -0,0 +1,63 @@
+#ifndef MYTINYSTL_POINTER_TRAITS_H_
+#define MYTINYSTL_POINTER_TRAITS_H_
+
+// 这个头文件包含模板类 pointer_traits 与函数 to_address
+// 配置器的 pointer 可以不是原生指针（例如 offset_ptr），容器通过它们
+// 得到指向其他类型的指针类型，以及把这类指针转换成原生指针
+
+#include <cstddef>
+#include <type_traits>
+
+namespace mystl
+{
+    // element_type 为 void 时 pointer_to 没有意义，参数用这个不完整的类型占位
+    struct pointer_traits_nat;
+
+    template <class Ptr>
+    struct pointer_traits
+    {
+        typedef Ptr pointer;
+        typedef typename Ptr::element_type element_type;
+        typedef typename Ptr::difference_type difference_type;
+
+        template <class U>
+        using rebind = typename Ptr::template rebind<U>;
+
+        static pointer pointer_to(typename std::conditional<std::is_void<element_type>::value,
+                                                            pointer_traits_nat,
+                                                            element_type>::type &r)
+        {
+            return Ptr::pointer_to(r);
+        }
+    };
+
+    template <class T>
+    struct pointer_traits<T *>
+    {
+        typedef T *pointer;
+        typedef T element_type;
+        typedef ptrdiff_t difference_type;
+
+        template <class U>
+        using rebind = U *;
+
+        static pointer pointer_to(typename std::conditional<std::is_void<T>::value,
+                                                            pointer_traits_nat, T>::type &r) noexcept
+        {
+            return &r;
+        }
+    };
+
+    // 取得指针指向的原生地址，fancy pointer 通过 operator-> 取得
+    template <class T>
+    constexpr T *to_address(T *p) noexcept
+    {
+        return p;
+    }
+    template <class Ptr>
+    auto to_address(const Ptr &p) noexcept -> decltype(mystl::to_address(p.operator->()))
+    {
+        return mystl::to_address(p.operator->());
+    }
+} // namespace mystl
+#endif // !MYTINYSTL_POINTER_TRAITS_H_
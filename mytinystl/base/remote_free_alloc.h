@@ -0,0 +1,210 @@
+#ifndef MYTINYSTL_REMOTE_FREE_ALLOC_H_
+#define MYTINYSTL_REMOTE_FREE_ALLOC_H_
+
+// 这个头文件包含一个类 remote_free_alloc，适合一个线程分配、另一个线程释放的场景
+// 每个线程拥有一个 heap，heap 中每个大小等级有一条私有的 free list
+// 每个区块前面有 8 字节的头部，记录分配它的 heap（owner）：
+//   owner 线程释放时直接挂回私有 free list，不加锁
+//   其他线程释放时用 CAS 压入 owner 的 remote 队列（多生产者单消费者的无锁栈），
+//   owner 在下一次分配时用一次 exchange 取走整个队列，再分发到私有 free list
+// 私有 free list 为空时从 pool_alloc 批量取区块，超过高水位时批量归还
+// 线程退出时 heap 把缓存的区块还给 pool_alloc 后挂到废弃列表，由之后新建的线程接手，
+// 因此退出之后才到达的 remote 释放也不会丢失
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+#include "alloc.h"
+
+namespace mystl
+{
+    class remote_free_alloc
+    {
+    public:
+        static constexpr size_t align = pool_alloc::align;
+        static constexpr size_t header_size = sizeof(void *);                  // 区块头部的大小
+        static constexpr size_t max_bytes = pool_alloc::max_bytes - header_size; // 小区块的上限
+        static constexpr size_t free_list_count = pool_alloc::free_list_count;
+        static constexpr size_t high_water = 256; // 每个大小等级缓存的区块上限
+
+    private:
+        struct heap
+        {
+            free_list_node *free_list[free_list_count] = {};
+            size_t count[free_list_count] = {};
+            std::atomic<free_list_node *> remote_head{nullptr}; // 其他线程释放的区块
+            heap *next_abandoned = nullptr;
+
+            void push_remote(free_list_node *block, size_t index) noexcept;
+            void drain_remote() noexcept;
+            void release(size_t i, size_t n);
+            void release_all();
+        };
+
+        // 线程退出时把 heap 交还给废弃列表
+        struct heap_owner
+        {
+            heap *h;
+            heap_owner() : h(acquire_heap()) {}
+            ~heap_owner() { abandon_heap(h); }
+        };
+
+        inline static heap *abandoned_ = nullptr; // 等待新线程接手的 heap
+        inline static std::mutex abandoned_mutex_;
+
+    public:
+        static void *allocate(size_t n);
+        static void deallocate(void *ptr, size_t n);
+
+    private:
+        static heap &local()
+        {
+            thread_local heap_owner owner;
+            return *owner.h;
+        }
+        static heap *acquire_heap();
+        static void abandon_heap(heap *h);
+
+        // 带头部的区块大小对应的 free list
+        // 其他线程释放时在头部之后写入 remote 队列的链接，所以数据部分至少要放得下一个指针，
+        // 否则 0 字节的区块只有头部，链接会写到下一个区块的头部上
+        static size_t block_index(size_t n) noexcept
+        {
+            const size_t data = n < sizeof(free_list_node *) ? sizeof(free_list_node *) : n;
+            return pool_alloc::free_list_index(data + header_size);
+        }
+        static heap *&owner_of(free_list_node *block) noexcept
+        {
+            return *reinterpret_cast<heap **>(block);
+        }
+    };
+
+    // 其他线程释放：区块的头部暂时改存大小等级，以便 owner 分发
+    inline void remote_free_alloc::heap::push_remote(free_list_node *block, size_t index) noexcept
+    {
+        *reinterpret_cast<size_t *>(block) = index;
+        free_list_node *link = reinterpret_cast<free_list_node *>(block->data + header_size);
+        free_list_node *head = remote_head.load(std::memory_order_relaxed);
+        do
+        {
+            link->next = head;
+        } while (!remote_head.compare_exchange_weak(head, block, std::memory_order_release,
+                                                    std::memory_order_relaxed));
+    }
+
+    // owner 取走 remote 队列中的全部区块，只有 owner 会消费，exchange 不会有 ABA 问题
+    inline void remote_free_alloc::heap::drain_remote() noexcept
+    {
+        free_list_node *block = remote_head.exchange(nullptr, std::memory_order_acquire);
+        while (block != nullptr)
+        {
+            free_list_node *link = reinterpret_cast<free_list_node *>(block->data + header_size);
+            free_list_node *next = link->next;
+            const size_t i = *reinterpret_cast<size_t *>(block);
+            block->next = free_list[i];
+            free_list[i] = block;
+            ++count[i];
+            block = next;
+        }
+    }
+
+    // 把第 i 条 free list 头部的 n 个区块归还给 pool_alloc
+    inline void remote_free_alloc::heap::release(size_t i, size_t n)
+    {
+        if (n == 0 || free_list[i] == nullptr)
+            return;
+        free_list_node *first = free_list[i];
+        free_list_node *last = first;
+        size_t k = 1;
+        for (; k < n && last->next != nullptr; ++k)
+            last = last->next;
+        free_list[i] = last->next;
+        count[i] -= k;
+        pool_alloc::deallocate_batch(first, last, (i + 1) * align);
+    }
+
+    inline void remote_free_alloc::heap::release_all()
+    {
+        drain_remote();
+        for (size_t i = 0; i < free_list_count; ++i)
+            release(i, count[i]);
+    }
+
+    // 新线程优先接手废弃的 heap，heap 本身从不释放
+    inline remote_free_alloc::heap *remote_free_alloc::acquire_heap()
+    {
+        {
+            std::lock_guard<std::mutex> lock(abandoned_mutex_);
+            if (abandoned_ != nullptr)
+            {
+                heap *h = abandoned_;
+                abandoned_ = h->next_abandoned;
+                h->next_abandoned = nullptr;
+                return h;
+            }
+        }
+        return new heap;
+    }
+
+    inline void remote_free_alloc::abandon_heap(heap *h)
+    {
+        h->release_all();
+        std::lock_guard<std::mutex> lock(abandoned_mutex_);
+        h->next_abandoned = abandoned_;
+        abandoned_ = h;
+    }
+
+    // 分配大小为 n 的空间，返回头部之后的位置
+    inline void *remote_free_alloc::allocate(size_t n)
+    {
+        if (n > max_bytes)
+            return ::operator new(n);
+        heap &h = local();
+        if (h.remote_head.load(std::memory_order_relaxed) != nullptr)
+            h.drain_remote();
+        const size_t i = block_index(n);
+        free_list_node *block = h.free_list[i];
+        if (block == nullptr)
+        {
+            size_t nobjs = high_water / 2;
+            block = pool_alloc::allocate_batch((i + 1) * align, nobjs);
+            h.free_list[i] = block->next;
+            h.count[i] = nobjs - 1;
+        }
+        else
+        {
+            h.free_list[i] = block->next;
+            --h.count[i];
+        }
+        owner_of(block) = &h;
+        return block->data + header_size;
+    }
+
+    // 释放 ptr 指向的大小为 n 的空间，n 必须与分配时的大小一致，可以在任意线程调用
+    inline void remote_free_alloc::deallocate(void *ptr, size_t n)
+    {
+        if (ptr == nullptr)
+            return;
+        if (n > max_bytes)
+        {
+            ::operator delete(ptr, n);
+            return;
+        }
+        free_list_node *block = reinterpret_cast<free_list_node *>(static_cast<char *>(ptr) - header_size);
+        const size_t i = block_index(n);
+        heap *owner = owner_of(block);
+        heap &h = local();
+        if (owner != &h)
+        {
+            owner->push_remote(block, i);
+            return;
+        }
+        block->next = h.free_list[i];
+        h.free_list[i] = block;
+        if (++h.count[i] > high_water)
+            h.release(i, high_water / 2);
+    }
+} // namespace mystl
+#endif // !MYTINYSTL_REMOTE_FREE_ALLOC_H_
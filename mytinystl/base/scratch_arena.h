@@ -0,0 +1,161 @@
+#ifndef MYTINYSTL_SCRATCH_ARENA_H_
+#define MYTINYSTL_SCRATCH_ARENA_H_
+
+// 这个头文件包含类 scratch_arena，为 get_temporary_buffer / temporary_buffer 提供临时空间
+// 每个线程一个 scratch_arena，第一次使用时申请一块连续空间，之后按后进先出的顺序
+// 用指针递增分配、回退释放，归并、稳定排序这类算法的临时缓冲区不再经过全局堆
+// 不按后进先出的顺序释放也是安全的：arena 记录每块空间的起点，释放的不是最后一块时只做标记，
+// 等它上面的空间都释放后再一起回退；同时存在的空间超过 max_live 块时，新的申请退回堆上
+// 剩余空间放不下时才退回 malloc（对齐超过 max_align_t 时用带对齐参数的 ::operator new），
+// 并且和原来一样，申请失败时把长度减半再试
+// high_water() 记录 arena 用到的最高位置，可以据此调整大小
+// 定义宏 MYSTL_SCRATCH_ARENA_BYTES 可以修改每个线程 arena 的大小，默认 256KB
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "exceptdef.h"
+
+#ifndef MYSTL_SCRATCH_ARENA_BYTES
+#define MYSTL_SCRATCH_ARENA_BYTES (256 * 1024)
+#endif
+
+namespace mystl
+{
+    class scratch_arena
+    {
+    public:
+        static constexpr size_t default_bytes = MYSTL_SCRATCH_ARENA_BYTES;
+        static constexpr size_t max_live = 32; // arena 中同时存在的空间块数上限
+
+    private:
+        // arena 中的一块空间
+        struct mark
+        {
+            char *start;    // allocate 返回的地址
+            char *prev_top; // 分配之前的 top_，释放时回退到这里
+            bool released;  // 已释放，但上面还有没释放的空间
+        };
+
+        mark marks_[max_live];
+        size_t depth_;       // marks_ 中的块数
+        char *begin_;        // arena 的起始位置，第一次分配时才申请
+        char *top_;          // 下一次分配的位置
+        char *end_;          // arena 的结尾
+        size_t high_water_;  // top_ 到过的最高偏移
+        size_t fallbacks_;   // 退回 malloc 的次数
+        size_t bytes_;       // arena 的大小
+
+    public:
+        explicit scratch_arena(size_t bytes = default_bytes) noexcept
+            : depth_(0), begin_(nullptr), top_(nullptr), end_(nullptr), high_water_(0), fallbacks_(0), bytes_(bytes)
+        {
+        }
+        scratch_arena(const scratch_arena &) = delete;
+        scratch_arena &operator=(const scratch_arena &) = delete;
+        ~scratch_arena()
+        {
+            MYSTL_DEBUG(top_ == begin_ && depth_ == 0);
+            ::operator delete(begin_, bytes_);
+        }
+
+        // 当前线程的 arena
+        static scratch_arena &local() noexcept
+        {
+            thread_local scratch_arena arena;
+            return arena;
+        }
+
+        // 申请最多 len 个大小为 size、对齐为 align 的对象，返回地址与实际个数，
+        // 个数可能小于 len，失败时为 (nullptr, 0)
+        void *allocate(ptrdiff_t &len, size_t size, size_t align) noexcept;
+        // 释放 allocate 返回的空间，align 与申请时相同
+        void deallocate(void *ptr, size_t align) noexcept;
+
+        bool owns(const void *ptr) const noexcept
+        {
+            return begin_ != nullptr && static_cast<const char *>(ptr) >= begin_ &&
+                   static_cast<const char *>(ptr) < end_;
+        }
+
+        size_t capacity() const noexcept { return bytes_; }
+        size_t used() const noexcept { return static_cast<size_t>(top_ - begin_); }
+        size_t high_water() const noexcept { return high_water_; }
+        size_t fallbacks() const noexcept { return fallbacks_; }
+
+    private:
+        void *fallback(ptrdiff_t &len, size_t size, size_t align) noexcept;
+    };
+
+    inline void *scratch_arena::allocate(ptrdiff_t &len, size_t size, size_t align) noexcept
+    {
+        if (len <= 0)
+        {
+            len = 0;
+            return nullptr;
+        }
+        if (begin_ == nullptr)
+        {
+            begin_ = static_cast<char *>(::operator new(bytes_, std::nothrow));
+            if (begin_ == nullptr)
+                return fallback(len, size, align);
+            top_ = begin_;
+            end_ = begin_ + bytes_;
+        }
+        const uintptr_t top = reinterpret_cast<uintptr_t>(top_);
+        char *p = top_ + ((align - top % align) % align);
+        if (depth_ < max_live && p <= end_ && static_cast<size_t>(len) <= static_cast<size_t>(end_ - p) / size)
+        {
+            marks_[depth_++] = mark{p, top_, false};
+            top_ = p + len * size;
+            if (used() > high_water_)
+                high_water_ = used();
+            return p;
+        }
+        return fallback(len, size, align);
+    }
+
+    inline void scratch_arena::deallocate(void *ptr, size_t align) noexcept
+    {
+        if (ptr == nullptr)
+            return;
+        if (owns(ptr))
+        {
+            // 先标记为已释放，再从最后一块开始把连续的已释放空间一起回退
+            size_t i = depth_;
+            while (i > 0 && marks_[i - 1].start != ptr)
+                --i;
+            MYSTL_DEBUG(i > 0);
+            if (i == 0)
+                return;
+            marks_[i - 1].released = true;
+            while (depth_ > 0 && marks_[depth_ - 1].released)
+                top_ = marks_[--depth_].prev_top;
+            return;
+        }
+        if (align > alignof(std::max_align_t))
+            ::operator delete(ptr, std::align_val_t(align));
+        else
+            std::free(ptr);
+    }
+
+    // arena 放不下时使用 malloc，失败时把长度减半再试
+    inline void *scratch_arena::fallback(ptrdiff_t &len, size_t size, size_t align) noexcept
+    {
+        ++fallbacks_;
+        while (len > 0)
+        {
+            const size_t bytes = static_cast<size_t>(len) * size;
+            void *p = align > alignof(std::max_align_t)
+                          ? ::operator new(bytes, std::align_val_t(align), std::nothrow)
+                          : std::malloc(bytes);
+            if (p != nullptr)
+                return p;
+            len /= 2;
+        }
+        return nullptr;
+    }
+} // namespace mystl
+#endif // !MYTINYSTL_SCRATCH_ARENA_H_
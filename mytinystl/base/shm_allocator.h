@@ -0,0 +1,342 @@
+#ifndef MYTINYSTL_SHM_ALLOCATOR_H_
+#define MYTINYSTL_SHM_ALLOCATOR_H_
+
+// 这个头文件包含共享内存中的分配器，用于进程间零拷贝地共享容器
+// shm_arena     : 位于共享内存开头的分配器，只保存相对偏移，映射到任何地址都有效；
+//                 区块按 2 的幂分成大小等级，释放的区块挂回对应等级的 free list，
+//                 用一个进程间共享的自旋锁保护，多个进程可以同时分配与释放
+// shm_segment   : 进程内的句柄，用 shm_open + mmap 创建或打开一段 POSIX 共享内存，
+//                 并通过 construct_root / root 找到放在其中的根对象
+// shm_allocator : pointer 为 offset_ptr<T> 的配置器，容器放在共享内存中时，
+//                 容器内部的指针和配置器本身都只保存偏移
+//   例：mystl::shm_segment seg("/demo", 1 << 20);
+//       typedef mystl::vector<int, mystl::shm_allocator<int>> shm_vector;
+//       auto *v = seg.construct_root<shm_vector>(mystl::shm_allocator<int>(seg));
+//       另一个进程：mystl::shm_segment seg("/demo"); seg.root<shm_vector>()->size();
+// 元素类型本身若含有指针（例如 vector<string>），元素也要使用 shm_allocator
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+#include "exceptdef.h"
+#include "offset_ptr.h"
+#include "pointer_traits.h"
+#include "util.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MYSTL_HAS_SHM 1
+#endif
+
+namespace mystl
+{
+    class shm_arena
+    {
+    public:
+        static constexpr size_t align = 16;        // 所有区块的对齐
+        static constexpr size_t class_count = 48; // 大小等级 16 << i
+        static constexpr char magic[8] = {'M', 'Y', 'S', 'T', 'L', 'S', 'H', 'M'};
+
+    private:
+        char magic_[8];
+        size_t size_;                 // 整段内存的大小
+        size_t top_;                  // 尚未切分部分的起始偏移
+        size_t used_;                 // 已分配出去的字节数（按大小等级计）
+        size_t free_list_[class_count]; // 每个等级的空闲区块偏移，0 表示空
+        std::atomic<uint32_t> lock_;  // 进程间共享，只能是无锁的原子变量
+        offset_ptr<void> root_;       // 根对象，另一个进程从这里开始访问
+
+        static_assert(std::atomic<uint32_t>::is_always_lock_free,
+                      "shm_arena needs a lock-free atomic to work across processes");
+
+    public:
+        // 在 base 开始的 size 字节中建立 arena，返回 arena 的地址
+        static shm_arena *create(void *base, size_t size);
+        // base 开始的内存中已经有 arena 时返回它，否则返回 nullptr
+        static shm_arena *attach(void *base) noexcept;
+
+        shm_arena(const shm_arena &) = delete;
+        shm_arena &operator=(const shm_arena &) = delete;
+
+        void *allocate(size_t bytes);
+        void deallocate(void *ptr, size_t bytes) noexcept;
+
+        void *root() const noexcept { return root_.get(); }
+        void set_root(void *p) noexcept { root_ = p; }
+
+        size_t size() const noexcept { return size_; }
+        size_t used() const noexcept { return used_; }
+
+    private:
+        explicit shm_arena(size_t size) noexcept;
+
+        char *base() noexcept { return reinterpret_cast<char *>(this); }
+        static size_t class_of(size_t bytes) noexcept
+        {
+            size_t i = 0;
+            while ((align << i) < bytes)
+                ++i;
+            return i;
+        }
+        void lock() noexcept
+        {
+            uint32_t expected = 0;
+            while (!lock_.compare_exchange_weak(expected, 1, std::memory_order_acquire,
+                                                std::memory_order_relaxed))
+            {
+                expected = 0;
+                std::this_thread::yield();
+            }
+        }
+        void unlock() noexcept { lock_.store(0, std::memory_order_release); }
+    };
+
+    inline shm_arena::shm_arena(size_t size) noexcept
+        : size_(size), top_((sizeof(shm_arena) + align - 1) & ~(align - 1)), used_(0),
+          free_list_(), lock_(0), root_()
+    {
+        std::memcpy(magic_, magic, sizeof(magic_));
+    }
+
+    inline shm_arena *shm_arena::create(void *base, size_t size)
+    {
+        THROW_LENGTH_ERROR_IF(size < sizeof(shm_arena), "shm_arena: segment is too small");
+        MYSTL_DEBUG(reinterpret_cast<uintptr_t>(base) % align == 0);
+        return ::new (base) shm_arena(size);
+    }
+
+    inline shm_arena *shm_arena::attach(void *base) noexcept
+    {
+        shm_arena *arena = static_cast<shm_arena *>(base);
+        return std::memcmp(arena->magic_, magic, sizeof(magic)) == 0 ? arena : nullptr;
+    }
+
+    // 先从对应等级的 free list 中取，没有时从尚未切分的部分切出
+    inline void *shm_arena::allocate(size_t bytes)
+    {
+        const size_t i = class_of(bytes == 0 ? 1 : bytes);
+        if (i >= class_count)
+            throw std::bad_alloc();
+        const size_t block = align << i;
+        lock();
+        size_t offset = free_list_[i];
+        if (offset != 0)
+        {
+            free_list_[i] = *reinterpret_cast<size_t *>(base() + offset);
+        }
+        else if (block <= size_ - top_)
+        {
+            offset = top_;
+            top_ += block;
+        }
+        else
+        {
+            unlock();
+            throw std::bad_alloc();
+        }
+        used_ += block;
+        unlock();
+        return base() + offset;
+    }
+
+    // bytes 必须与分配时的大小一致
+    inline void shm_arena::deallocate(void *ptr, size_t bytes) noexcept
+    {
+        if (ptr == nullptr)
+            return;
+        const size_t i = class_of(bytes == 0 ? 1 : bytes);
+        const size_t offset = static_cast<size_t>(static_cast<char *>(ptr) - base());
+        MYSTL_DEBUG(offset >= sizeof(shm_arena) && offset < size_);
+        lock();
+        *static_cast<size_t *>(ptr) = free_list_[i];
+        free_list_[i] = offset;
+        used_ -= align << i;
+        unlock();
+    }
+
+#ifdef MYSTL_HAS_SHM
+    // --------------------------------------------------------------------------------------
+    // shm_segment：进程内的句柄，析构时只解除映射，共享内存对象要用 remove 删除
+    class shm_segment
+    {
+    private:
+        void *base_;
+        size_t size_;
+        shm_arena *arena_;
+
+    public:
+        // 创建名为 name、大小为 size 字节的共享内存，已经存在时覆盖
+        shm_segment(const char *name, size_t size);
+        // 打开另一个进程创建的共享内存
+        explicit shm_segment(const char *name);
+        shm_segment(const shm_segment &) = delete;
+        shm_segment &operator=(const shm_segment &) = delete;
+        ~shm_segment()
+        {
+            if (base_ != nullptr)
+                ::munmap(base_, size_);
+        }
+
+        // 删除共享内存对象，已经打开它的进程不受影响
+        static bool remove(const char *name) noexcept { return ::shm_unlink(name) == 0; }
+
+        shm_arena *arena() const noexcept { return arena_; }
+        void *base() const noexcept { return base_; }
+        size_t size() const noexcept { return size_; }
+
+        // 在共享内存中构造根对象，其他进程通过 root<T>() 取得
+        template <class T, class... Args>
+        T *construct_root(Args &&...args)
+        {
+            void *p = arena_->allocate(sizeof(T));
+            T *obj;
+            try
+            {
+                obj = ::new (p) T(mystl::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                arena_->deallocate(p, sizeof(T));
+                throw;
+            }
+            arena_->set_root(obj);
+            return obj;
+        }
+        template <class T>
+        T *root() const noexcept
+        {
+            return static_cast<T *>(arena_->root());
+        }
+        // 析构并释放根对象
+        template <class T>
+        void destroy_root()
+        {
+            T *obj = root<T>();
+            if (obj == nullptr)
+                return;
+            obj->~T();
+            arena_->deallocate(obj, sizeof(T));
+            arena_->set_root(nullptr);
+        }
+
+    private:
+        void map(int fd, size_t size);
+    };
+
+    inline shm_segment::shm_segment(const char *name, size_t size)
+        : base_(nullptr), size_(0), arena_(nullptr)
+    {
+        int fd = ::shm_open(name, O_CREAT | O_RDWR | O_TRUNC, 0600);
+        THROW_RUNTIME_ERROR_IF(fd < 0, "shm_segment: shm_open failed");
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            ::close(fd);
+            THROW_RUNTIME_ERROR_IF(true, "shm_segment: ftruncate failed");
+        }
+        map(fd, size);
+        arena_ = shm_arena::create(base_, size_);
+    }
+
+    inline shm_segment::shm_segment(const char *name)
+        : base_(nullptr), size_(0), arena_(nullptr)
+    {
+        int fd = ::shm_open(name, O_RDWR, 0600);
+        THROW_RUNTIME_ERROR_IF(fd < 0, "shm_segment: shm_open failed");
+        struct stat st;
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            THROW_RUNTIME_ERROR_IF(true, "shm_segment: fstat failed");
+        }
+        map(fd, static_cast<size_t>(st.st_size));
+        arena_ = shm_arena::attach(base_);
+        if (arena_ == nullptr)
+        {
+            ::munmap(base_, size_);
+            base_ = nullptr;
+            THROW_RUNTIME_ERROR_IF(true, "shm_segment: not a mystl segment");
+        }
+    }
+
+    // 映射后文件描述符即可关闭
+    inline void shm_segment::map(int fd, size_t size)
+    {
+        void *p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        THROW_RUNTIME_ERROR_IF(p == MAP_FAILED, "shm_segment: mmap failed");
+        base_ = p;
+        size_ = size;
+    }
+#endif // MYSTL_HAS_SHM
+
+    // --------------------------------------------------------------------------------------
+    // 模板类：shm_allocator
+    // 保存 arena 的 offset_ptr，配置器放在共享内存中时在其他进程里同样有效
+    template <class T>
+    class shm_allocator
+    {
+    public:
+        typedef T value_type;
+        typedef offset_ptr<T> pointer;
+        typedef offset_ptr<const T> const_pointer;
+        typedef T &reference;
+        typedef const T &const_reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        template <class U>
+        struct rebind
+        {
+            typedef shm_allocator<U> other;
+        };
+
+        // 内存跟着 arena 走，移动与交换时配置器一起传播
+        typedef std::true_type propagate_on_container_move_assignment;
+        typedef std::true_type propagate_on_container_swap;
+        typedef std::false_type is_always_equal;
+
+        static_assert(alignof(T) <= shm_arena::align, "alignment of T is too large for shm_arena");
+
+    private:
+        offset_ptr<shm_arena> arena_;
+
+    public:
+        explicit shm_allocator(shm_arena *arena) noexcept : arena_(arena) {}
+#ifdef MYSTL_HAS_SHM
+        shm_allocator(const shm_segment &segment) noexcept : arena_(segment.arena()) {}
+#endif
+        template <class U>
+        shm_allocator(const shm_allocator<U> &other) noexcept : arena_(other.arena()) {}
+
+        pointer allocate(size_type n)
+        {
+            return static_cast<T *>(arena_->allocate(n * sizeof(T)));
+        }
+        void deallocate(pointer ptr, size_type n) noexcept
+        {
+            arena_->deallocate(mystl::to_address(ptr), n * sizeof(T));
+        }
+
+        shm_arena *arena() const noexcept { return arena_.get(); }
+    };
+
+    template <class T, class U>
+    bool operator==(const shm_allocator<T> &lhs, const shm_allocator<U> &rhs) noexcept
+    {
+        return lhs.arena() == rhs.arena();
+    }
+    template <class T, class U>
+    bool operator!=(const shm_allocator<T> &lhs, const shm_allocator<U> &rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+} // namespace mystl
+#endif // !MYTINYSTL_SHM_ALLOCATOR_H_
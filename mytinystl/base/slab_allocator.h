@@ -0,0 +1,212 @@
+#ifndef MYTINYSTL_SLAB_ALLOCATOR_H_
+#define MYTINYSTL_SLAB_ALLOCATOR_H_
+
+// 这个头文件包含 slab_pool 与模板类 slab_allocator，用于 list 结点这类大小固定的对象
+// slab_pool      : 每次向系统申请一整块连续的 slab，从中依次切出结点，
+//                  释放的结点挂到嵌入在结点内的 free list 上，下次优先复用
+// slab_allocator : 持有 slab_pool 指针的配置器，单个对象的请求交给 slab_pool，
+//                  多个 list 传入同一个 slab_pool 即可共享结点的内存
+//   例：mystl::slab_pool pool;
+//       mystl::list<int, mystl::slab_allocator<int>> a(&pool), b(&pool);
+// slab_pool 不是线程安全的，也必须比使用它的容器活得更久
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+#include "allocator.h"
+#include "exceptdef.h"
+
+namespace mystl
+{
+    class slab_pool
+    {
+    public:
+        static constexpr size_t default_slab_bytes = 64 * 1024; // 默认每个 slab 的大小
+
+    private:
+        // 每个 slab 头部的信息，slab 之间组成单链表
+        struct slab_header
+        {
+            slab_header *next;
+        };
+        // 空闲结点中嵌入的 free list 指针
+        struct free_node
+        {
+            free_node *next;
+        };
+
+    private:
+        size_t node_size_;     // 结点大小，第一次分配时确定
+        size_t node_align_;    // 结点的对齐
+        size_t slab_bytes_;    // 每个 slab 的大小
+        free_node *free_list_; // 被释放的结点
+        char *cur_;            // 当前 slab 中下一个可切出的位置
+        char *end_;            // 当前 slab 的结尾
+        slab_header *slabs_;   // 已申请的 slab
+        size_t slab_count_;    // 已申请的 slab 个数
+
+    public:
+        explicit slab_pool(size_t slab_bytes = default_slab_bytes) noexcept
+            : node_size_(0), node_align_(0), slab_bytes_(slab_bytes), free_list_(nullptr),
+              cur_(nullptr), end_(nullptr), slabs_(nullptr), slab_count_(0)
+        {
+        }
+        slab_pool(const slab_pool &) = delete;
+        slab_pool &operator=(const slab_pool &) = delete;
+        ~slab_pool() { release(); }
+
+        // 取出一个结点，同一个 slab_pool 只能用于一种大小的对象
+        void *allocate(size_t bytes, size_t alignment)
+        {
+            if (node_size_ == 0)
+                init_node(bytes, alignment);
+            MYSTL_DEBUG(bytes <= node_size_ && alignment <= node_align_);
+            if (free_list_ != nullptr)
+            {
+                free_node *result = free_list_;
+                free_list_ = result->next;
+                return result;
+            }
+            if (cur_ == end_)
+                new_slab();
+            void *result = cur_;
+            cur_ += node_size_;
+            return result;
+        }
+        // 归还一个结点，O(1)
+        void deallocate(void *ptr) noexcept
+        {
+            free_node *node = static_cast<free_node *>(ptr);
+            node->next = free_list_;
+            free_list_ = node;
+        }
+
+        // 把所有 slab 还给系统，调用者保证此时没有结点仍在使用
+        void release() noexcept;
+
+        size_t node_size() const noexcept { return node_size_; }
+        size_t slab_count() const noexcept { return slab_count_; }
+
+    private:
+        void init_node(size_t bytes, size_t alignment) noexcept
+        {
+            node_align_ = alignment < alignof(free_node) ? alignof(free_node) : alignment;
+            const size_t size = bytes < sizeof(free_node) ? sizeof(free_node) : bytes;
+            node_size_ = (size + node_align_ - 1) & ~(node_align_ - 1);
+        }
+        // slab 头部之后第一个结点的偏移
+        size_t header_size() const noexcept
+        {
+            return (sizeof(slab_header) + node_align_ - 1) & ~(node_align_ - 1);
+        }
+        size_t slab_align() const noexcept
+        {
+            return node_align_ < alignof(slab_header) ? alignof(slab_header) : node_align_;
+        }
+        void new_slab();
+    };
+
+    // 申请一个新的 slab，至少能放下一个结点
+    inline void slab_pool::new_slab()
+    {
+        size_t bytes = slab_bytes_;
+        if (bytes < header_size() + node_size_)
+            bytes = header_size() + node_size_;
+        void *raw = slab_align() > __STDCPP_DEFAULT_NEW_ALIGNMENT__
+                        ? ::operator new(bytes, std::align_val_t(slab_align()))
+                        : ::operator new(bytes);
+        slab_header *slab = static_cast<slab_header *>(raw);
+        slab->next = slabs_;
+        slabs_ = slab;
+        ++slab_count_;
+        cur_ = static_cast<char *>(raw) + header_size();
+        // 只切整数个结点，尾部放不下一个结点的零头不用
+        end_ = cur_ + (bytes - header_size()) / node_size_ * node_size_;
+    }
+
+    inline void slab_pool::release() noexcept
+    {
+        size_t bytes = slab_bytes_;
+        if (node_size_ != 0 && bytes < header_size() + node_size_)
+            bytes = header_size() + node_size_;
+        while (slabs_ != nullptr)
+        {
+            slab_header *next = slabs_->next;
+            if (slab_align() > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+                ::operator delete(slabs_, bytes, std::align_val_t(slab_align()));
+            else
+                ::operator delete(slabs_, bytes);
+            slabs_ = next;
+        }
+        slab_count_ = 0;
+        free_list_ = nullptr;
+        cur_ = end_ = nullptr;
+    }
+
+    // --------------------------------------------------------------------------------------
+    // 模板类：slab_allocator
+    // 没有指定 slab_pool 时所有请求交给 allocator<T>
+    template <class T>
+    class slab_allocator
+    {
+    public:
+        typedef T value_type;
+        typedef T *pointer;
+        typedef const T *const_pointer;
+        typedef T &reference;
+        typedef const T &const_reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        template <class U>
+        struct rebind
+        {
+            typedef slab_allocator<U> other;
+        };
+
+        // 移动与交换时结点跟着 slab_pool 一起走，复制时新容器仍使用原来的 slab_pool
+        typedef std::true_type propagate_on_container_move_assignment;
+        typedef std::true_type propagate_on_container_swap;
+        typedef std::false_type is_always_equal;
+
+    private:
+        slab_pool *pool_;
+
+    public:
+        slab_allocator() noexcept : pool_(nullptr) {}
+        slab_allocator(slab_pool *pool) noexcept : pool_(pool) {}
+        template <class U>
+        slab_allocator(const slab_allocator<U> &other) noexcept : pool_(other.pool()) {}
+
+        pointer allocate(size_type n)
+        {
+            if (pool_ != nullptr && n == 1)
+                return static_cast<pointer>(pool_->allocate(sizeof(T), alignof(T)));
+            return mystl::allocator<T>::allocate(n);
+        }
+        void deallocate(pointer ptr, size_type n)
+        {
+            if (ptr == nullptr)
+                return;
+            if (pool_ != nullptr && n == 1)
+                pool_->deallocate(ptr);
+            else
+                mystl::allocator<T>::deallocate(ptr, n);
+        }
+
+        slab_pool *pool() const noexcept { return pool_; }
+    };
+
+    template <class T, class U>
+    bool operator==(const slab_allocator<T> &lhs, const slab_allocator<U> &rhs) noexcept
+    {
+        return lhs.pool() == rhs.pool();
+    }
+    template <class T, class U>
+    bool operator!=(const slab_allocator<T> &lhs, const slab_allocator<U> &rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+} // namespace mystl
+#endif // !MYTINYSTL_SLAB_ALLOCATOR_H_
@@ -0,0 +1,127 @@
+#ifndef MYTINYSTL_THREAD_CACHE_ALLOC_H_
+#define MYTINYSTL_THREAD_CACHE_ALLOC_H_
+
+// 这个头文件包含一个类 thread_cache_alloc，它是 pool_alloc 的线程缓存前端
+// 每个线程为每个大小等级维护一条私有的 free list，分配和释放都不需要加锁
+// 私有 free list 为空时从 pool_alloc 批量取回一批区块，超过高水位时批量归还一半
+// 线程退出时把缓存的区块全部归还给 pool_alloc
+
+#include <atomic>
+#include <cstddef>
+
+#include "alloc.h"
+
+namespace mystl
+{
+    class thread_cache_alloc
+    {
+    public:
+        static constexpr size_t align = pool_alloc::align;
+        static constexpr size_t max_bytes = pool_alloc::max_bytes;
+        static constexpr size_t free_list_count = pool_alloc::free_list_count;
+        static constexpr size_t default_high_water = 256; // 每个大小等级默认缓存的区块上限
+
+    private:
+        // 线程私有的缓存
+        struct thread_cache
+        {
+            free_list_node *free_list[free_list_count] = {};
+            size_t count[free_list_count] = {};
+
+            ~thread_cache()
+            {
+                for (size_t i = 0; i < free_list_count; ++i)
+                    release(i, count[i]);
+            }
+            // 把第 i 条 free list 头部的 n 个区块归还给 pool_alloc
+            void release(size_t i, size_t n);
+        };
+
+        // 各大小等级的高水位，0 表示使用 default_high_water
+        inline static std::atomic<size_t> high_water_[free_list_count] = {};
+
+    public:
+        static void *allocate(size_t n);
+        static void deallocate(void *ptr, size_t n);
+
+        // 设置 bytes 所在大小等级的高水位，对所有线程生效
+        static void set_high_water(size_t bytes, size_t count) noexcept
+        {
+            high_water_[pool_alloc::free_list_index(bytes)].store(count, std::memory_order_relaxed);
+        }
+        static size_t high_water(size_t bytes) noexcept
+        {
+            const size_t hw = high_water_[pool_alloc::free_list_index(bytes)]
+                                  .load(std::memory_order_relaxed);
+            return hw == 0 ? default_high_water : hw;
+        }
+
+    private:
+        static thread_cache &local() noexcept
+        {
+            thread_local thread_cache cache;
+            return cache;
+        }
+        // 每次与 pool_alloc 之间搬运的区块数：高水位的一半
+        static size_t batch_size(size_t bytes) noexcept
+        {
+            const size_t n = high_water(bytes) / 2;
+            return n == 0 ? 1 : n;
+        }
+    };
+
+    inline void thread_cache_alloc::thread_cache::release(size_t i, size_t n)
+    {
+        if (n == 0 || free_list[i] == nullptr)
+            return;
+        free_list_node *first = free_list[i];
+        free_list_node *last = first;
+        for (size_t k = 1; k < n && last->next != nullptr; ++k)
+            last = last->next;
+        free_list[i] = last->next;
+        count[i] -= n;
+        pool_alloc::deallocate_batch(first, last, (i + 1) * align);
+    }
+
+    // 分配大小为 n 的空间，线程缓存命中时不加锁
+    inline void *thread_cache_alloc::allocate(size_t n)
+    {
+        if (n > max_bytes)
+            return ::operator new(n);
+        const size_t i = pool_alloc::free_list_index(n);
+        thread_cache &cache = local();
+        free_list_node *result = cache.free_list[i];
+        if (result == nullptr)
+        {
+            size_t nobjs = batch_size(n);
+            result = pool_alloc::allocate_batch(n, nobjs);
+            cache.free_list[i] = result->next;
+            cache.count[i] = nobjs - 1;
+            return result;
+        }
+        cache.free_list[i] = result->next;
+        --cache.count[i];
+        return result;
+    }
+
+    // 释放 ptr 指向的大小为 n 的空间，n 必须与分配时的大小一致
+    // 可以在任意线程释放，区块会进入释放线程的缓存
+    inline void thread_cache_alloc::deallocate(void *ptr, size_t n)
+    {
+        if (ptr == nullptr)
+            return;
+        if (n > max_bytes)
+        {
+            ::operator delete(ptr, n);
+            return;
+        }
+        const size_t i = pool_alloc::free_list_index(n);
+        thread_cache &cache = local();
+        free_list_node *q = static_cast<free_list_node *>(ptr);
+        q->next = cache.free_list[i];
+        cache.free_list[i] = q;
+        if (++cache.count[i] > high_water(n))
+            cache.release(i, batch_size(n));
+    }
+} // namespace mystl
+#endif // !MYTINYSTL_THREAD_CACHE_ALLOC_H_
@@ -31,6 +31,17 @@ namespace mystl
     {
     };
 
+    // is_trivially_relocatable
+    // 把对象按字节复制到新地址、旧地址上不再调用析构函数，结果与移动构造再析构旧对象相同的类型，
+    // 容器扩容、插入、删除时可以用 memcpy / memmove 搬移这类元素
+    // 可以按字节复制的类型都满足；其他类型需要自己声明，例如只保存指向堆的指针、
+    // 不保存指向自身的指针的类：
+    //   template <> struct mystl::is_trivially_relocatable<my_type> : std::true_type {};
+    template <class T>
+    struct is_trivially_relocatable : std::integral_constant<bool, std::is_trivially_copyable<T>::value>
+    {
+    };
+
 }
 
 #endif
\ No newline at end of file
@@ -3,8 +3,11 @@
 
 // 这个头文件用于对未初始化空间构造元素
 
+#include <cstring>
+
 #include "algobase.h"
 #include "construct.h"
+#include "destroy.h"
 #include "iterator.h"
 #include "type_traits.h"
 #include "util.h"
@@ -251,5 +254,67 @@ namespace mystl
                                                       value_type>{});
     }
 
+    /*****************************************************************************************/
+    // uninitialized_relocate
+    // 把 [first, last) 上的对象搬到以 result 为起始处的未初始化空间，之后 [first, last) 视为未初始化
+    // is_trivially_relocatable 的类型直接 memmove，区间可以重叠，不会抛出异常；
+    // 其他类型逐个移动构造再析构旧对象，区间不能重叠
+    /*****************************************************************************************/
+    template <class T>
+    T *unchecked_uninit_relocate(T *first, T *last, T *result, std::true_type) noexcept
+    {
+        const auto n = static_cast<size_t>(last - first);
+        if (n != 0)
+            std::memmove(static_cast<void *>(result), static_cast<const void *>(first), n * sizeof(T));
+        return result + n;
+    }
+
+    template <class T>
+    T *unchecked_uninit_relocate(T *first, T *last, T *result, std::false_type)
+    {
+        T *cur = mystl::uninitialized_move(first, last, result);
+        mystl::destroy(first, last);
+        return cur;
+    }
+
+    template <class T>
+    T *uninitialized_relocate(T *first, T *last, T *result)
+    {
+        return mystl::unchecked_uninit_relocate(first, last, result,
+                                                mystl::is_trivially_relocatable<T>{});
+    }
+
+    /*****************************************************************************************/
+    // uninitialized_default_construct
+    // 在 [first, last) 上默认初始化对象，平凡类型什么也不做，内存中保留原来的内容
+    /*****************************************************************************************/
+    template <class T>
+    void unchecked_uninit_default_construct(T *, T *, std::true_type) noexcept
+    {
+    }
+
+    template <class T>
+    void unchecked_uninit_default_construct(T *first, T *last, std::false_type)
+    {
+        auto cur = first;
+        try
+        {
+            for (; cur != last; ++cur)
+                ::new ((void *)cur) T;
+        }
+        catch (...)
+        {
+            mystl::destroy(first, cur);
+            throw;
+        }
+    }
+
+    template <class T>
+    void uninitialized_default_construct(T *first, T *last)
+    {
+        mystl::unchecked_uninit_default_construct(first, last,
+                                                  std::is_trivially_default_constructible<T>{});
+    }
+
 } // namespace mystl
 #endif // !MYTINYSTL_UNINITIALIZED_H_
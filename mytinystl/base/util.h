@@ -299,6 +299,14 @@ namespace mystl
         return pair<Ty1, Ty2>(mystl::forward<Ty1>(first), mystl::forward<Ty2>(second));
     }
 
+    // 两个成员都可以按字节搬移时，pair 也可以
+    template <class Ty1, class Ty2>
+    struct is_trivially_relocatable<pair<Ty1, Ty2>>
+        : std::integral_constant<bool, is_trivially_relocatable<Ty1>::value &&
+                                           is_trivially_relocatable<Ty2>::value>
+    {
+    };
+
 }
 
 #endif // !MYTINYSTL_UTIL_H_
@@ -7,6 +7,8 @@
 
 #include "base/iterator.h"
 #include "base/memory.h"
+#include "base/allocator_traits.h"
+#include "base/memory_resource.h"
 #include "base/exceptdef.h"
 #include "base/functional.h"
 
@@ -83,30 +85,31 @@ namespace mystl
 #define STRING_INIT_SIZE 32
 
     //模板类basic_string
-    //参数1代表字符类型，参数二代表萃取字符类型的方式
-    template <typename CharType, typename CharTraits = mystl::char_traits<CharType>>
-    class basic_string
+    //参数1代表字符类型，参数二代表萃取字符类型的方式，参数三代表空间配置器
+    template <typename CharType, typename CharTraits = mystl::char_traits<CharType>,
+              typename Alloc = mystl::allocator<CharType>>
+    class basic_string : private mystl::allocator_holder<Alloc>
     {
     public:
         typedef CharTraits traits_type;
         typedef CharTraits char_traits;
-        typedef mystl::allocator<CharType> allocator_type;
-        typedef mystl::allocator<CharType> data_allocator;
+        typedef Alloc allocator_type;
+        typedef mystl::allocator_traits<Alloc> alloc_traits;
 
-        typedef typename allocator_type::value_type value_type;
-        typedef typename allocator_type::pointer pointer;
-        typedef typename allocator_type::const_pointer const_pointer;
-        typedef typename allocator_type::reference reference;
-        typedef typename allocator_type::const_reference const_reference;
-        typedef typename allocator_type::size_type size_type;
-        typedef typename allocator_type::difference_type difference_type;
+        typedef typename alloc_traits::value_type value_type;
+        typedef typename alloc_traits::pointer pointer;
+        typedef typename alloc_traits::const_pointer const_pointer;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef typename alloc_traits::size_type size_type;
+        typedef typename alloc_traits::difference_type difference_type;
 
         typedef value_type *iterator;
         typedef const value_type *const_iterator;
         typedef mystl::reverse_iterator<iterator> reverse_iterator;
         typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
 
-        allocator_type get_allocator() { return allocator_type(); }
+        allocator_type get_allocator() const { return data_alloc(); }
 
         // 没搞懂这两个函数是干啥用的
         static_assert(std::is_pod<CharType>::value,
@@ -120,77 +123,126 @@ namespace mystl
         static constexpr size_type npos = static_cast<size_type>(-1);
 
     private:
-        iterator buffer_;    //存储字符串的起始位置
+        // 配置器存放在基类中，空的配置器不占空间
+        typedef mystl::allocator_holder<Alloc> alloc_base;
+
+        // 移动赋值能否直接接管对方的缓冲区
+        static constexpr bool move_assign_steals =
+            alloc_traits::propagate_on_container_move_assignment::value ||
+            alloc_traits::is_always_equal::value;
+
+    private:
+        pointer buffer_;     //存储字符串的起始位置，使用配置器的 pointer 以便放入共享内存
         size_type size_;     //大小
         size_type capacity_; //容量
     public:
         // 构造函数
         basic_string() noexcept
+            : alloc_base()
+        {
+            try_init();
+        }
+        // 指定空间配置器，例如 pmr::string s(&arena)
+        explicit basic_string(const allocator_type &alloc) noexcept
+            : alloc_base(alloc)
         {
             try_init();
         }
         // 构造函数n个字符ch
-        basic_string(size_type n, value_type ch)
-            : buffer_(nullptr), size_(0), capacity_(0)
+        basic_string(size_type n, value_type ch, const allocator_type &alloc = allocator_type())
+            : alloc_base(alloc), buffer_(nullptr), size_(0), capacity_(0)
         {
             fill_init(n, ch);
         }
         // 构造函数
         basic_string(const basic_string &other, size_type pos)
-            : buffer_(nullptr), size_(0), capacity_(0)
+            : alloc_base(other.data_alloc()), buffer_(nullptr), size_(0), capacity_(0)
         {
             init_from(other.buffer_, pos, other.size_ - pos);
         }
         // 构造函数
         basic_string(const basic_string &other, size_type pos, size_type count)
-            : buffer_(nullptr), size_(0), capacity_(0)
+            : alloc_base(other.data_alloc()), buffer_(nullptr), size_(0), capacity_(0)
         {
             init_from(other.buffer_, pos, count);
         }
         // 构造函数，根据C风格字符串复制
-        basic_string(const_pointer str)
-            : buffer_(nullptr), size_(0), capacity_(0)
+        basic_string(const value_type *str, const allocator_type &alloc = allocator_type())
+            : alloc_base(alloc), buffer_(nullptr), size_(0), capacity_(0)
         {
             init_from(str, 0, char_traits::length(str));
         }
         // 复制count个字符
-        basic_string(const_pointer str, size_type count)
-            : buffer_(nullptr), size_(0), capacity_(0)
+        basic_string(const value_type *str, size_type count,
+                     const allocator_type &alloc = allocator_type())
+            : alloc_base(alloc), buffer_(nullptr), size_(0), capacity_(0)
         {
             init_from(str, 0, count);
         }
         // 通过迭代器复制
         template <class Iter, typename std::enable_if<
                                   mystl::is_input_iterator<Iter>::value, int>::type = 0>
-        basic_string(Iter first, Iter last)
+        basic_string(Iter first, Iter last, const allocator_type &alloc = allocator_type())
+            : alloc_base(alloc), buffer_(nullptr), size_(0), capacity_(0)
         {
             copy_init(first, last, iterator_category(first));
         }
 
-        // 拷贝构造函数
+        // 拷贝构造函数，新字符串的配置器由 select_on_container_copy_construction 决定
         basic_string(const basic_string &other)
-            : buffer_(nullptr), size_(0), capacity_(0)
+            : alloc_base(alloc_traits::select_on_container_copy_construction(other.data_alloc())),
+              buffer_(nullptr), size_(0), capacity_(0)
+        {
+            init_from(other.buffer_, 0, other.size_);
+        }
+        basic_string(const basic_string &other, const allocator_type &alloc)
+            : alloc_base(alloc), buffer_(nullptr), size_(0), capacity_(0)
         {
             init_from(other.buffer_, 0, other.size_);
         }
-        // 右值拷贝
+        // 右值拷贝，空间配置器随缓冲区一起转移
         basic_string(basic_string &&rhs) noexcept
-            : buffer_(rhs.buffer_), size_(rhs.size_), capacity_(rhs.capacity_)
+            : alloc_base(rhs.data_alloc()),
+              buffer_(rhs.buffer_), size_(rhs.size_), capacity_(rhs.capacity_)
         {
-            rhs.buffer = nullptr;
+            rhs.buffer_ = nullptr;
             rhs.size_ = 0;
             rhs.capacity_ = 0;
         }
+        // 指定配置器的右值拷贝，配置器不相等时复制字符
+        basic_string(basic_string &&rhs, const allocator_type &alloc)
+            : alloc_base(alloc), buffer_(nullptr), size_(0), capacity_(0)
+        {
+            if (data_alloc() == rhs.data_alloc())
+            {
+                buffer_ = rhs.buffer_;
+                size_ = rhs.size_;
+                capacity_ = rhs.capacity_;
+                rhs.buffer_ = nullptr;
+                rhs.size_ = 0;
+                rhs.capacity_ = 0;
+            }
+            else
+            {
+                init_from(rhs.buffer_, 0, rhs.size_);
+            }
+        }
         // 复制函数重载
         // 通过basic_string左值复制
         basic_string &operator=(const basic_string &rhs);
         // 通过basic_string右值复制
-        basic_string &operator=(basic_string &&rhs) noexcept;
+        basic_string &operator=(basic_string &&rhs) noexcept(move_assign_steals);
         // 通过C字符串复制
-        basic_string &operator=(const_pointer str);
+        basic_string &operator=(const value_type *str);
         // 通过字符复制
         basic_string &operator=(value_type ch);
 
+        // 析构函数
+        ~basic_string()
+        {
+            destroy_buffer();
+        }
+
     public:
         // 迭代器相关
         iterator begin() noexcept
@@ -247,7 +299,7 @@ namespace mystl
         // 容量相关操作
         bool empty() const noexcept
         {
-            return size_ = 0;
+            return size_ == 0;
         }
         size_type size() const noexcept
         {
@@ -296,7 +348,7 @@ namespace mystl
             MYSTL_DEBUG(!empty());
             return *(end() - 1);
         }
-        const_pointer c_str() const noexcept
+        const value_type *c_str() const noexcept
         {
             return to_raw_pointer();
         }
@@ -320,18 +372,18 @@ namespace mystl
         basic_string &append(size_type count, value_type ch);
         basic_string &append(value_type ch)
         {
-            append(1, ch);
+            return append(1, ch);
         }
         basic_string &append(const basic_string &str)
         {
             return append(str, 0, str.size_);
         }
         basic_string &append(const basic_string &str, size_type pos, size_type count);
-        basic_string &append(const_pointer s)
+        basic_string &append(const value_type *s)
         {
             return append(s, char_traits::length(s));
         }
-        basic_string &append(const_pointer s, size_type count);
+        basic_string &append(const value_type *s, size_type count);
 
         // erase()、resize()、clear()
         iterator erase(const_iterator pos);
@@ -342,6 +394,12 @@ namespace mystl
             resize(count, value_type());
         }
         void resize(size_type count, value_type ch);
+        // 扩大时新增的字符不做 char_traits::fill，内容未定，用作 I/O 缓冲区时由调用者随后写入
+        void resize_default_init(size_type count);
+        // 先按 resize_default_init 扩到 count，再调用 op(指向首字符的指针, count) 写入内容，
+        // op 返回最终的长度（不超过 count）
+        template <class Operation>
+        void resize_and_overwrite(size_type count, Operation op);
 
         void clear() noexcept
         {
@@ -406,6 +464,10 @@ namespace mystl
 
     private:
         // 辅助函数
+        // 取得配置器
+        allocator_type &data_alloc() noexcept { return alloc_base::get(); }
+        const allocator_type &data_alloc() const noexcept { return alloc_base::get(); }
+
         // 初始化和销毁
         void try_init() noexcept;
         void fill_init(size_type n, value_type ch);
@@ -413,15 +475,15 @@ namespace mystl
         void copy_init(Iter first, Iter last, mystl::input_iterator_tag);
         template <class Iter>
         void copy_init(Iter first, Iter last, mystl::forward_iterator_tag);
-        void init_from(const_pointer src, size_type pos, size_type n);
+        void init_from(const value_type *src, size_type pos, size_type n);
         void destroy_buffer();
 
         // get raw pointer
-        const_pointer to_raw_pointer() const;
+        const value_type *to_raw_pointer() const;
 
         // compare
-        int compare_cstr(const_pointer s1, size_type n1,
-                         const_pointer s2, size_type n2) const;
+        int compare_cstr(const value_type *s1, size_type n1,
+                         const value_type *s2, size_type n2) const;
         // reallocate
         void reallocate(size_type need);
         iterator reallocate_and_fill(iterator pos, size_type n, value_type ch);
@@ -431,25 +493,41 @@ namespace mystl
 
     /*赋值函数重载*/
     // 赋值函数
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits> &
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc> &
+    basic_string<CharType, CharTraits, Alloc>::
     operator=(const basic_string &rhs)
     {
         if (this != &rhs)
         {
-            basic_string tmp(rhs);
+            // 需要传播且配置器不同时，旧的缓冲区必须用旧的配置器先释放
+            if (alloc_traits::propagate_on_container_copy_assignment::value &&
+                !(data_alloc() == rhs.data_alloc()))
+                destroy_buffer();
+            alloc_traits::copy_assign(data_alloc(), rhs.data_alloc());
+            basic_string tmp(rhs.buffer_, rhs.size_, data_alloc());
             swap(tmp);
         }
         return *this;
     }
     // 移动赋值函数
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits> &
-    basic_string<CharType, CharTraits>::
-    operator=(basic_string &&rhs) noexcept
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc> &
+    basic_string<CharType, CharTraits, Alloc>::
+    operator=(basic_string &&rhs) noexcept(move_assign_steals)
     {
+        if (this == &rhs)
+            return *this;
+        if (!move_assign_steals && !(data_alloc() == rhs.data_alloc()))
+        {
+            // 配置器不传播且不同时不能接管 rhs 的缓冲区，只能复制字符
+            basic_string tmp(rhs.buffer_, rhs.size_, data_alloc());
+            swap(tmp);
+            rhs.clear();
+            return *this;
+        }
         destroy_buffer();
+        alloc_traits::move_assign(data_alloc(), rhs.data_alloc());
         buffer_ = rhs.buffer_;
         size_ = rhs.size_;
         capacity_ = rhs.capacity_;
@@ -459,16 +537,16 @@ namespace mystl
         return *this;
     }
     // 用一个C风格字符串赋值
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits> &
-    basic_string<CharType, CharTraits>::
-    operator=(const_pointer str)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc> &
+    basic_string<CharType, CharTraits, Alloc>::
+    operator=(const value_type *str)
     {
         const size_type len = char_traits::length(str);
-        if (capacity_ < len)
+        if (capacity_ < len + 1)
         {
-            auto new_buffer_ = data_allocator::allocate(len + 1);
-            data_allocator::deallocate(buffer_);
+            auto new_buffer_ = alloc_traits::allocate(data_alloc(), len + 1);
+            alloc_traits::deallocate(data_alloc(), buffer_, capacity_);
             buffer_ = new_buffer_;
             capacity_ = len + 1;
         }
@@ -477,15 +555,15 @@ namespace mystl
         return *this;
     }
     // 用字符赋值
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits> &
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc> &
+    basic_string<CharType, CharTraits, Alloc>::
     operator=(value_type ch)
     {
-        if (capacity_ < 1)
+        if (capacity_ < 2)
         {
-            auto new_buffer = data_allocator::allocate(2);
-            data_allocator::deallocate(buffer_);
+            auto new_buffer = alloc_traits::allocate(data_alloc(), 2);
+            alloc_traits::deallocate(data_alloc(), buffer_, capacity_);
             buffer_ = new_buffer;
             capacity_ = 2;
         }
@@ -497,18 +575,18 @@ namespace mystl
     /***************************************************************/
     /*插入函数*/
     // 在 pos 处插入一个元素
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::iterator
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::iterator
+    basic_string<CharType, CharTraits, Alloc>::
         insert(const_iterator pos, value_type ch)
     {
         // 调用插入count个字符的情况
         insert(pos, 1, ch);
     }
     // 在pos处插入n个元素
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::iterator
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::iterator
+    basic_string<CharType, CharTraits, Alloc>::
         insert(const_iterator pos, size_type count, value_type ch)
     {
         iterator r = const_cast<iterator>(pos);
@@ -530,9 +608,9 @@ namespace mystl
         return r;
     }
     // append，在末尾添加n个字符ch
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits> &
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc> &
+    basic_string<CharType, CharTraits, Alloc>::
         append(size_type count, value_type ch)
     {
         THROW_LENGTH_ERROR_IF(size_ > max_size() - count,
@@ -546,9 +624,9 @@ namespace mystl
         return *this;
     }
     // 在末尾添加[str[pos:pos+count]一段
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits> &
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc> &
+    basic_string<CharType, CharTraits, Alloc>::
         append(const basic_string &str, size_type pos, size_type count)
     {
         THROW_LENGTH_ERROR_IF(size_ > max_size() - count,
@@ -564,12 +642,12 @@ namespace mystl
         return *this;
     }
     // 在末尾添加c_str的前count个字符
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits> &
-    basic_string<CharType, CharTraits>::
-        append(const_pointer s, size_type count)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc> &
+    basic_string<CharType, CharTraits, Alloc>::
+        append(const value_type *s, size_type count)
     {
-        THROW_LENGHT_ERROR_IF(size_ > max_size() - count,
+        THROW_LENGTH_ERROR_IF(size_ > max_size() - count,
                               "basic_string<Char, Tratis>'s size too big");
         if (capacity_ - size_ < count)
         {
@@ -583,9 +661,9 @@ namespace mystl
     /***************************************************************/
     /*erase*/
     //删除一个迭代器pos指向的元素
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::iterator
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::iterator
+    basic_string<CharType, CharTraits, Alloc>::
         erase(const_iterator pos)
     {
         MYSTL_DEBUG(pos != end());
@@ -595,9 +673,9 @@ namespace mystl
         return r;
     }
     // 删除[first,last)的元素
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::iterator
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::iterator
+    basic_string<CharType, CharTraits, Alloc>::
         erase(const_iterator first, const_iterator last)
     {
         if (first == begin() && last == end())
@@ -614,8 +692,8 @@ namespace mystl
     /***************************************************************/
     // 重置容器大小：resize
     // 重置为count个ch
-    template <class CharType, class CharTraits>
-    void basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    void basic_string<CharType, CharTraits, Alloc>::
         resize(size_type count, value_type ch)
     {
         if (count < size_)
@@ -627,18 +705,42 @@ namespace mystl
             append(count - size_, ch);
         }
     }
+    // 重置大小，不填充新增的字符
+    template <class CharType, class CharTraits, class Alloc>
+    void basic_string<CharType, CharTraits, Alloc>::
+        resize_default_init(size_type count)
+    {
+        THROW_LENGTH_ERROR_IF(count >= max_size(), "basic_string<Char, Traits>'s size too big");
+        // 留出 c_str() 结尾 '\0' 的位置
+        if (count >= capacity_)
+        {
+            reallocate(count + 1 - capacity_);
+        }
+        size_ = count;
+    }
+    // 扩到 count 后由 op 写入内容，op 返回最终的长度
+    template <class CharType, class CharTraits, class Alloc>
+    template <class Operation>
+    void basic_string<CharType, CharTraits, Alloc>::
+        resize_and_overwrite(size_type count, Operation op)
+    {
+        resize_default_init(count);
+        const auto result = static_cast<size_type>(op(mystl::to_address(buffer_), count));
+        MYSTL_DEBUG(result <= count);
+        size_ = result;
+    }
     /***************************************************************/
     // compare：比较两个basic_string，小于返回-1，大于返回1，等于返回0
-    template <class CharType, class CharTraits>
-    int basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    int basic_string<CharType, CharTraits, Alloc>::
         compare(const basic_string &other) const
     {
         return compare_cstr(buffer_, size_, other.buffer_, other.size_);
     }
     /***************************************************************/
     // reverse：反转 basic_string
-    template <class CharType, class CharTraits>
-    void basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    void basic_string<CharType, CharTraits, Alloc>::
         reverse() noexcept
     {
         for (auto i = begin(), j = end(); i < j;)
@@ -648,12 +750,16 @@ namespace mystl
     }
     /***************************************************************/
     // swap：和另一个rhs交换
-    template <class CharType, class CharTraits>
-    void basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    void basic_string<CharType, CharTraits, Alloc>::
         swap(basic_string &rhs) noexcept
     {
-        if (this != rhs)
+        // 配置器不传播时，只有相等的配置器才能交换缓冲区
+        MYSTL_DEBUG(alloc_traits::propagate_on_container_swap::value ||
+                    data_alloc() == rhs.data_alloc());
+        if (this != &rhs)
         {
+            alloc_traits::swap(data_alloc(), rhs.data_alloc());
             mystl::swap(buffer_, rhs.buffer_);
             mystl::swap(size_, rhs.size_);
             mystl::swap(capacity_, rhs.capacity_);
@@ -661,9 +767,9 @@ namespace mystl
     }
     /***************************************************************/
     // find：从pos开始查找ch
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         find(value_type ch, size_type pos) const noexcept
     {
         for (auto i = pos; i < size_; ++i)
@@ -674,9 +780,9 @@ namespace mystl
         return npos;
     }
     // find：从pos开始查找str
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         find(const basic_string &str, size_type pos) const noexcept
     {
         const size_type count = str.size_;
@@ -702,9 +808,9 @@ namespace mystl
         return npos;
     }
     // rfind：从后往前查找ch
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         rfind(value_type ch, size_type pos) const noexcept
     {
         if (pos >= size_)
@@ -717,9 +823,9 @@ namespace mystl
         return npos;
     }
     // rfind：从后往前查找str
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::size_type
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::size_type
+    basic_string<CharType, CharTraits, Alloc>::
         rfind(const basic_string &str, size_type pos) const noexcept
     {
         const size_type count = str.size_;
@@ -749,15 +855,15 @@ namespace mystl
     /*以下为辅助函数*/
     /*************************************************************************/
     // 尝试初始化一段buffer，若分配失败则忽略，不会抛出异常
-    template <class CharType, class CharTraits>
-    void basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    void basic_string<CharType, CharTraits, Alloc>::
         try_init() noexcept
     {
         try
         {
-            buffer_ = data_allocator::allocate(static_cast<size_type>(STRING_INIT_SIZE));
+            buffer_ = alloc_traits::allocate(data_alloc(), static_cast<size_type>(STRING_INIT_SIZE));
             size_ = 0;
-            capacity_ = 0;
+            capacity_ = static_cast<size_type>(STRING_INIT_SIZE);
         }
         catch (...)
         {
@@ -767,78 +873,88 @@ namespace mystl
         }
     }
     // fill_init：用字符ch来初始化
-    template <class CharType, class CharTraits>
-    void basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    void basic_string<CharType, CharTraits, Alloc>::
         fill_init(size_type n, value_type ch)
     {
 
         const auto init_size = mystl::max(static_cast<size_type>(STRING_INIT_SIZE), n + 1);
-        buffer_ = data_allocator::allocate(init_size);
+        buffer_ = alloc_traits::allocate(data_alloc(), init_size);
         char_traits::fill(buffer_, ch, n);
         size_ = n;
         capacity_ = init_size;
     }
     // copy_inti：用迭代器来初始化
-    template <class CharType, class CharTraits>
+    template <class CharType, class CharTraits, class Alloc>
     template <class Iter>
-    void basic_string<CharType, CharTraits>::
+    void basic_string<CharType, CharTraits, Alloc>::
         copy_init(Iter first, Iter last, mystl::input_iterator_tag)
     {
-        size_type n = mystl::distance(first, last);
-        const auto init_size = mystl::max(static_cast<size_type>(STRING_INIT_SIZE), n + 1);
+        const auto init_size = static_cast<size_type>(STRING_INIT_SIZE);
+        buffer_ = alloc_traits::allocate(data_alloc(), init_size);
+        size_ = 0;
+        capacity_ = init_size;
         try
         {
-            buffer_ = data_allocator::allocate(init_size);
-            size_ = n;
-            capacity_ = init_size;
+            for (; first != last; ++first)
+                append(*first);
         }
         catch (...)
         {
-            buffer_ = nullptr;
-            size_ = 0;
-            capacity_ = 0;
+            destroy_buffer();
             throw;
         }
-        for (; n > 0; --n, ++first)
-            append(*first);
+    }
+    // copy_inti：用前向迭代器来初始化，可以预先算出长度一次分配
+    template <class CharType, class CharTraits, class Alloc>
+    template <class Iter>
+    void basic_string<CharType, CharTraits, Alloc>::
+        copy_init(Iter first, Iter last, mystl::forward_iterator_tag)
+    {
+        const size_type n = mystl::distance(first, last);
+        const auto init_size = mystl::max(static_cast<size_type>(STRING_INIT_SIZE), n + 1);
+        buffer_ = alloc_traits::allocate(data_alloc(), init_size);
+        size_ = n;
+        capacity_ = init_size;
+        mystl::uninitialized_copy(first, last, buffer_);
     }
     // init_from：从C风格字符串初始化，从src的pos处开始的count个字符
-    template <class CharType, class CharTraits>
-    void basic_string<CharType, CharTraits>::
-        init_from(const_pointer src, size_type pos, size_type count)
+    template <class CharType, class CharTraits, class Alloc>
+    void basic_string<CharType, CharTraits, Alloc>::
+        init_from(const value_type *src, size_type pos, size_type count)
     {
         const auto init_size = mystl::max(static_cast<size_type>(STRING_INIT_SIZE), count + 1);
-        buffer_ = data_allocator::allocate(init_size);
+        buffer_ = alloc_traits::allocate(data_alloc(), init_size);
         char_traits::copy(buffer_, src + pos, count);
         size_ = count;
         capacity_ = init_size;
     }
     // destroy_buffer函数
-    template <class CharType, class CharTraits>
-    void basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    void basic_string<CharType, CharTraits, Alloc>::
         destroy_buffer()
     {
         if (buffer_ != nullptr)
         {
-            data_allocator::deallocate(buffer_, capacity_);
+            alloc_traits::deallocate(data_alloc(), buffer_, capacity_);
             buffer_ = nullptr;
             size_ = 0;
             capacity_ = 0;
         }
     }
     // to_raw_pointer函数：返回一个c风格字符串
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::const_pointer
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    const typename basic_string<CharType, CharTraits, Alloc>::value_type *
+    basic_string<CharType, CharTraits, Alloc>::
         to_raw_pointer() const
     {
         *(buffer_ + size_) = value_type();
         return buffer_;
     }
     // 比较C风格字符串
-    template <class CharType, class CharTraits>
-    int basic_string<CharType, CharTraits>::
-        compare_cstr(const_pointer s1, size_type n1, const_pointer s2, size_type n2) const
+    template <class CharType, class CharTraits, class Alloc>
+    int basic_string<CharType, CharTraits, Alloc>::
+        compare_cstr(const value_type *s1, size_type n1, const value_type *s2, size_type n2) const
     {
         auto len = mystl::min(n1, n2);
         auto res = char_traits::compare(s1, s2, len);
@@ -852,55 +968,59 @@ namespace mystl
     }
     /*******************************************************************************/
     // reallocate函数：重新添加内存，长度为need
-    template <class CharType, class CharTraits>
-    void basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    void basic_string<CharType, CharTraits, Alloc>::
         reallocate(size_type need)
     {
         const auto new_capacity_ = mystl::max(capacity_ + need, capacity_ + (capacity_ >> 1));
-        auto new_buffer = data_allocator::allocate(new_capacity_);
+        // 配置器实际给出的空间可能比请求的多，多出的部分也计入容量
+        const auto block = alloc_traits::allocate_at_least(data_alloc(), new_capacity_);
+        auto new_buffer = block.ptr;
         char_traits::move(new_buffer, buffer_, size_);
-        data_allocator::deallocate(buffer_);
+        alloc_traits::deallocate(data_alloc(), buffer_, capacity_);
         buffer_ = new_buffer;
-        capacity_ = new_capacity_;
+        capacity_ = block.count;
     }
     // reallocate_and_fill函数：在pos位置插入n个ch字符
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::iterator
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::iterator
+    basic_string<CharType, CharTraits, Alloc>::
         reallocate_and_fill(iterator pos, size_type n, value_type ch)
     {
         const auto r = pos - buffer_;
         const auto old_cap = capacity_;
         const auto new_cap = mystl::max(old_cap + n, old_cap + (old_cap >> 1));
-        auto new_buffer = data_allocator::allocate(new_cap);
+        const auto block = alloc_traits::allocate_at_least(data_alloc(), new_cap);
+        auto new_buffer = block.ptr;
         auto e1 = char_traits::move(new_buffer, buffer_, r) + r;
         auto e2 = char_traits::fill(e1, ch, n) + n;
         char_traits::move(e2, buffer_ + r, size_ - r);
-        data_allocator::deallocate(buffer_, old_cap);
+        alloc_traits::deallocate(data_alloc(), buffer_, old_cap);
         buffer_ = new_buffer;
         size_ += n;
-        capacity_ = new_cap;
+        capacity_ = block.count;
         return buffer_ + r;
     }
 
     // reallocate_and_copy函数：把[first,last)复制添加到pos处
-    template <class CharType, class CharTraits>
-    typename basic_string<CharType, CharTraits>::iterator
-    basic_string<CharType, CharTraits>::
+    template <class CharType, class CharTraits, class Alloc>
+    typename basic_string<CharType, CharTraits, Alloc>::iterator
+    basic_string<CharType, CharTraits, Alloc>::
         reallocate_and_copy(iterator pos, const_iterator first, const_iterator last)
     {
         const auto r = pos - buffer_;
         const auto old_cap = capacity_;
         const size_type n = mystl::distance(first, last);
         const auto new_cap = mystl::max(old_cap + n, old_cap + (old_cap >> 1));
-        auto new_buffer = data_allocator::allocate(new_cap);
+        const auto block = alloc_traits::allocate_at_least(data_alloc(), new_cap);
+        auto new_buffer = block.ptr;
         auto e1 = char_traits::move(new_buffer, buffer_, r) + r;
         auto e2 = mystl::uninitialized_copy_n(first, n, e1) + n;
         char_traits::move(e2, buffer_ + r, size_ - r);
-        data_allocator::deallocate(buffer_, old_cap);
+        alloc_traits::deallocate(data_alloc(), buffer_, old_cap);
         buffer_ = new_buffer;
         size_ += n;
-        capacity_ = new_cap;
+        capacity_ = block.count;
         return buffer_ + r;
     }
 
@@ -908,178 +1028,192 @@ namespace mystl
     /*重载全局操作符*/
     // 重载operator+
     // string+string
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(const basic_string<CharType, CharTraits> &lhs,
-              const basic_string<CharType, CharTraits> &rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(const basic_string<CharType, CharTraits, Alloc> &lhs,
+              const basic_string<CharType, CharTraits, Alloc> &rhs)
     {
-        basic_string<CharType, CharTraits> tmp(lhs);
+        basic_string<CharType, CharTraits, Alloc> tmp(lhs);
         tmp.append(rhs);
         return tmp;
     }
     // c_string+string
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(const CharType *lhs, const basic_string<CharType, CharTraits> &rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(const CharType *lhs, const basic_string<CharType, CharTraits, Alloc> &rhs)
     {
-        basic_string<CharType, CharTraits> tmp(lhs);
+        basic_string<CharType, CharTraits, Alloc> tmp(lhs);
         tmp.append(rhs);
         return tmp;
     }
     // char+string
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(CharType ch, const basic_string<CharType, CharTraits> &rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(CharType ch, const basic_string<CharType, CharTraits, Alloc> &rhs)
     {
-        basic_string<CharType, CharTraits> tmp(1, ch);
+        basic_string<CharType, CharTraits, Alloc> tmp(1, ch);
         tmp.append(rhs);
         return tmp;
     }
     // string+c_string;
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(const basic_string<CharType, CharTraits> &lhs, const CharType *rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(const basic_string<CharType, CharTraits, Alloc> &lhs, const CharType *rhs)
     {
-        basic_string<CharType, CharTraits> tmp(lhs);
+        basic_string<CharType, CharTraits, Alloc> tmp(lhs);
         tmp.append(rhs);
         return tmp;
     }
     // string+char
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(const basic_string<CharType, CharTraits> &lhs, CharType ch)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(const basic_string<CharType, CharTraits, Alloc> &lhs, CharType ch)
     {
-        basic_string<CharType, CharTraits> tmp(lhs);
+        basic_string<CharType, CharTraits, Alloc> tmp(lhs);
         tmp.append(1, ch);
         return tmp;
     }
     // string（右值）+string
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(basic_string<CharType, CharTraits> &&lhs, const basic_string<CharType, CharTraits> &rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(basic_string<CharType, CharTraits, Alloc> &&lhs, const basic_string<CharType, CharTraits, Alloc> &rhs)
     {
-        basic_string<CharType, CharTraits> tmp(mystl::move(lhs));
+        basic_string<CharType, CharTraits, Alloc> tmp(mystl::move(lhs));
         tmp.append(rhs);
         return tmp;
     }
     // string + string(右值)
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(const basic_string<CharType, CharTraits> &lhs, basic_string<CharType, CharTraits> &&rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(const basic_string<CharType, CharTraits, Alloc> &lhs, basic_string<CharType, CharTraits, Alloc> &&rhs)
     {
-        basic_string<CharType, CharTraits> tmp(mystl::move(rhs));
+        basic_string<CharType, CharTraits, Alloc> tmp(mystl::move(rhs));
         tmp.insert(tmp.begin(), lhs.begin(), lhs.end());
         return tmp;
     }
     // string(右值)+string(右值)
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(basic_string<CharType, CharTraits> &&lhs,
-              basic_string<CharType, CharTraits> &&rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(basic_string<CharType, CharTraits, Alloc> &&lhs,
+              basic_string<CharType, CharTraits, Alloc> &&rhs)
     {
-        basic_string<CharType, CharTraits> tmp(mystl::move(lhs));
+        basic_string<CharType, CharTraits, Alloc> tmp(mystl::move(lhs));
         tmp.append(rhs);
         return tmp;
     }
     // c_string+string(右值)
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(const CharType *lhs, basic_string<CharType, CharTraits> &&rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(const CharType *lhs, basic_string<CharType, CharTraits, Alloc> &&rhs)
     {
-        basic_string<CharType, CharTraits> tmp(lhs);
+        basic_string<CharType, CharTraits, Alloc> tmp(lhs);
         tmp.append(rhs);
         return tmp;
     }
     // char+string（右值）
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(CharType ch, basic_string<CharType, CharTraits> &&rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(CharType ch, basic_string<CharType, CharTraits, Alloc> &&rhs)
     {
-        basic_string<CharType, CharTraits> tmp(ch);
+        basic_string<CharType, CharTraits, Alloc> tmp(ch);
         tmp.append(rhs);
         return tmp;
     }
     // string（右值）+ c_string
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(basic_string<CharType, CharTraits> &&lhs, const CharType *rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(basic_string<CharType, CharTraits, Alloc> &&lhs, const CharType *rhs)
     {
-        basic_string<CharType, CharTraits> tmp(mystl::move(lhs));
+        basic_string<CharType, CharTraits, Alloc> tmp(mystl::move(lhs));
         tmp.append(rhs);
         return tmp;
     }
     // string（右值）+ char
-    template <class CharType, class CharTraits>
-    basic_string<CharType, CharTraits>
-    operator+(basic_string<CharType, CharTraits> &&lhs, CharType ch)
+    template <class CharType, class CharTraits, class Alloc>
+    basic_string<CharType, CharTraits, Alloc>
+    operator+(basic_string<CharType, CharTraits, Alloc> &&lhs, CharType ch)
     {
-        basic_string<CharType, CharTraits> tmp(mystl::move(lhs));
+        basic_string<CharType, CharTraits, Alloc> tmp(mystl::move(lhs));
         tmp.append(1, ch);
         return tmp;
     }
     /*****************************************************************************/
     // 重载operator==
     // string==string
-    template <class CharType, class CharTraits>
-    bool operator==(const basic_string<CharType, CharTraits> &lhs,
-                    const basic_string<CharType, CharTraits> &rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    bool operator==(const basic_string<CharType, CharTraits, Alloc> &lhs,
+                    const basic_string<CharType, CharTraits, Alloc> &rhs)
     {
         return lhs.size() == rhs.size() && lhs.compare(rhs) == 0;
     }
     // string!=string
-    template <class CharType, class CharTraits>
-    bool operator!=(const basic_string<CharType, CharTraits> &lhs,
-                    const basic_string<CharType, CharTraits> &rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    bool operator!=(const basic_string<CharType, CharTraits, Alloc> &lhs,
+                    const basic_string<CharType, CharTraits, Alloc> &rhs)
     {
         return lhs.size() != rhs.size() || lhs.compare(rhs) != 0;
     }
     /*****************************************************************************/
     // 重载operator<、>、<=、>=
     // string < string
-    template <class CharType, class CharTraits>
-    bool operator<(const basic_string<CharType, CharTraits> &lhs,
-                   const basic_string<CharType, CharTraits> &rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    bool operator<(const basic_string<CharType, CharTraits, Alloc> &lhs,
+                   const basic_string<CharType, CharTraits, Alloc> &rhs)
     {
         return lhs.compare(rhs) < 0;
     }
     // string <= string
-    template <class CharType, class CharTraits>
-    bool operator<=(const basic_string<CharType, CharTraits> &lhs,
-                    const basic_string<CharType, CharTraits> &rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    bool operator<=(const basic_string<CharType, CharTraits, Alloc> &lhs,
+                    const basic_string<CharType, CharTraits, Alloc> &rhs)
     {
         return lhs.compare(rhs) <= 0;
     }
     // string > string
-    template <class CharType, class CharTraits>
-    bool operator>(const basic_string<CharType, CharTraits> &lhs,
-                   const basic_string<CharType, CharTraits> &rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    bool operator>(const basic_string<CharType, CharTraits, Alloc> &lhs,
+                   const basic_string<CharType, CharTraits, Alloc> &rhs)
     {
         return lhs.compare(rhs) > 0;
     }
     // string >= string
-    template <class CharType, class CharTraits>
-    bool operator>=(const basic_string<CharType, CharTraits> &lhs,
-                    const basic_string<CharType, CharTraits> &rhs)
+    template <class CharType, class CharTraits, class Alloc>
+    bool operator>=(const basic_string<CharType, CharTraits, Alloc> &lhs,
+                    const basic_string<CharType, CharTraits, Alloc> &rhs)
     {
         return lhs.compare(rhs) >= 0;
     }
     /****************************************************************************/
     // 重载mystl的swap
-    template <class CharType, class CharTraits>
-    void swap(basic_string<CharType, CharTraits> &lhs,
-              basic_string<CharType, CharTraits> &rhs) noexcept
+    template <class CharType, class CharTraits, class Alloc>
+    void swap(basic_string<CharType, CharTraits, Alloc> &lhs,
+              basic_string<CharType, CharTraits, Alloc> &rhs) noexcept
     {
         lhs.swap(rhs);
     }
+    // 没有短字符串优化，缓冲区总在堆上，配置器和指针都能按字节搬移时 basic_string 也可以
+    template <class CharType, class CharTraits, class Alloc>
+    struct is_trivially_relocatable<basic_string<CharType, CharTraits, Alloc>>
+        : std::integral_constant<bool, is_trivially_relocatable<Alloc>::value &&
+                                           is_trivially_relocatable<typename allocator_traits<Alloc>::pointer>::value>
+    {
+    };
     // 特化mystl的hash
-    template <class CharType, class CharTraits>
-    struct hash<basic_string<CharType, CharTraits>>
+    template <class CharType, class CharTraits, class Alloc>
+    struct hash<basic_string<CharType, CharTraits, Alloc>>
     {
-        size_t operator()(const basic_string<CharType, CharTraits> &str)
+        size_t operator()(const basic_string<CharType, CharTraits, Alloc> &str)
         {
             return bitwise_hash((const unsigned char *)str.c_str(),
                                 str.size() * sizeof(CharType));
         }
     };
+
+    namespace pmr
+    {
+        template <class CharType, class CharTraits = mystl::char_traits<CharType>>
+        using basic_string = mystl::basic_string<CharType, CharTraits,
+                                                 polymorphic_allocator<CharType>>;
+    }
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,480 @@
+#ifndef MYTINYSTL_BIT_VECTOR_H_
+#define MYTINYSTL_BIT_VECTOR_H_
+
+// 这个头文件包含类 bit_vector，每个元素只占一位，代替被禁用的 vector<bool>
+// 位按 64 位字存放在 mystl::vector<uint64_t> 中：第 i 位在第 i / 64 个字的第 i % 64 位，
+// 最后一个字中超出 size() 的位始终为 0，因此 count、find、比较都可以整字处理
+// operator[] 返回代理类 bit_reference，迭代器是随机访问迭代器，解引用同样得到代理
+// 按字处理的操作：
+//   count() / find_first() / find_next(pos) : popcount / ctz，find 找不到时返回 npos
+//   for_each_set(f)                         : 对每个 1 的下标调用 f，遍历稠密的掩码时比 find_next 快
+//   &=、|=、^=、and_not(rhs)                : 两个 bit_vector 的大小必须相同，见 base/bit_ops.h 中的 SIMD 实现
+//   count_and(rhs)                          : (*this & rhs).count()，不写回、不产生临时对象
+// 只支持在末尾增删（push_back / pop_back / resize），不提供 insert / erase
+//   例：mystl::bit_vector<> mask(n);  mask.set(3);  mask &= other;
+//       for (auto i = mask.find_first(); i != mask.npos; i = mask.find_next(i)) ...
+
+#include <cstdint>
+#include <initializer_list>
+
+#include "base/bit_ops.h"
+#include "base/allocator_traits.h"
+#include "base/exceptdef.h"
+#include "my_vector.h"
+
+namespace mystl
+{
+    // 代理引用：一个字的指针与位的掩码
+    class bit_reference
+    {
+    private:
+        uint64_t *word_;
+        uint64_t mask_;
+
+    public:
+        bit_reference(uint64_t *word, unsigned bit) noexcept : word_(word), mask_(uint64_t(1) << bit) {}
+
+        operator bool() const noexcept { return (*word_ & mask_) != 0; }
+        bool operator~() const noexcept { return (*word_ & mask_) == 0; }
+
+        bit_reference &operator=(bool value) noexcept
+        {
+            if (value)
+                *word_ |= mask_;
+            else
+                *word_ &= ~mask_;
+            return *this;
+        }
+        bit_reference &operator=(const bit_reference &rhs) noexcept { return *this = bool(rhs); }
+
+        void flip() noexcept { *word_ ^= mask_; }
+    };
+
+    inline void swap(bit_reference a, bit_reference b) noexcept
+    {
+        const bool tmp = a;
+        a = bool(b);
+        b = tmp;
+    }
+
+    // 迭代器保存字数组的起点与位的下标，IsConst 为真时解引用得到 bool
+    template <bool IsConst>
+    struct bit_iterator
+    {
+        typedef random_access_iterator_tag iterator_category;
+        typedef bool value_type;
+        typedef ptrdiff_t difference_type;
+        typedef void pointer;
+        typedef typename std::conditional<IsConst, bool, bit_reference>::type reference;
+        typedef typename std::conditional<IsConst, const uint64_t *, uint64_t *>::type word_pointer;
+        typedef bit_iterator self;
+
+        word_pointer words;
+        size_t pos;
+
+        bit_iterator() noexcept : words(nullptr), pos(0) {}
+        bit_iterator(word_pointer w, size_t p) noexcept : words(w), pos(p) {}
+        // iterator 可以转换为 const_iterator
+        bit_iterator(const bit_iterator<false> &rhs) noexcept : words(rhs.words), pos(rhs.pos) {}
+
+        reference operator*() const noexcept { return deref(std::integral_constant<bool, IsConst>{}); }
+        reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+        self &operator++() noexcept
+        {
+            ++pos;
+            return *this;
+        }
+        self operator++(int) noexcept
+        {
+            self tmp = *this;
+            ++pos;
+            return tmp;
+        }
+        self &operator--() noexcept
+        {
+            --pos;
+            return *this;
+        }
+        self operator--(int) noexcept
+        {
+            self tmp = *this;
+            --pos;
+            return tmp;
+        }
+        self &operator+=(difference_type n) noexcept
+        {
+            pos += n;
+            return *this;
+        }
+        self &operator-=(difference_type n) noexcept
+        {
+            pos -= n;
+            return *this;
+        }
+        self operator+(difference_type n) const noexcept { return self(words, pos + n); }
+        self operator-(difference_type n) const noexcept { return self(words, pos - n); }
+        difference_type operator-(const self &rhs) const noexcept
+        {
+            return static_cast<difference_type>(pos) - static_cast<difference_type>(rhs.pos);
+        }
+
+        bool operator==(const self &rhs) const noexcept { return pos == rhs.pos; }
+        bool operator!=(const self &rhs) const noexcept { return pos != rhs.pos; }
+        bool operator<(const self &rhs) const noexcept { return pos < rhs.pos; }
+        bool operator>(const self &rhs) const noexcept { return pos > rhs.pos; }
+        bool operator<=(const self &rhs) const noexcept { return pos <= rhs.pos; }
+        bool operator>=(const self &rhs) const noexcept { return pos >= rhs.pos; }
+
+    private:
+        bool deref(std::true_type) const noexcept { return (words[pos / 64] >> (pos % 64)) & 1; }
+        bit_reference deref(std::false_type) const noexcept
+        {
+            return bit_reference(words + pos / 64, static_cast<unsigned>(pos % 64));
+        }
+    };
+
+    template <bool IsConst>
+    bit_iterator<IsConst> operator+(ptrdiff_t n, const bit_iterator<IsConst> &it) noexcept
+    {
+        return it + n;
+    }
+
+    // --------------------------------------------------------------------------------------
+    // 模板类：bit_vector
+    // Alloc 会被换成存放 uint64_t 的配置器
+    template <class Alloc = mystl::allocator<uint64_t>>
+    class bit_vector
+    {
+    public:
+        typedef uint64_t word_type;
+        typedef typename allocator_traits<Alloc>::template rebind_alloc<word_type> allocator_type;
+        typedef mystl::vector<word_type, allocator_type> word_vector;
+
+        typedef bool value_type;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+        typedef bit_reference reference;
+        typedef bool const_reference;
+        typedef bit_iterator<false> iterator;
+        typedef bit_iterator<true> const_iterator;
+        typedef mystl::reverse_iterator<iterator> reverse_iterator;
+        typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        static constexpr size_type bits_per_word = 64;
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+    private:
+        word_vector words_;
+        size_type size_;
+
+    public:
+        /*********************构造、复制、移动、析构**************/
+        bit_vector() noexcept : words_(), size_(0) {}
+        explicit bit_vector(const allocator_type &alloc) : words_(alloc), size_(0) {}
+        explicit bit_vector(size_type n, bool value = false, const allocator_type &alloc = allocator_type())
+            : words_(word_count(n), value ? ~word_type(0) : word_type(0), alloc), size_(n)
+        {
+            clear_tail();
+        }
+        bit_vector(std::initializer_list<bool> ilist, const allocator_type &alloc = allocator_type())
+            : words_(word_count(ilist.size()), word_type(0), alloc), size_(ilist.size())
+        {
+            size_type i = 0;
+            for (bool b : ilist)
+            {
+                if (b)
+                    words_[i / bits_per_word] |= word_type(1) << (i % bits_per_word);
+                ++i;
+            }
+        }
+        bit_vector(const bit_vector &) = default;
+        bit_vector(bit_vector &&rhs) noexcept : words_(mystl::move(rhs.words_)), size_(rhs.size_)
+        {
+            rhs.clear();
+        }
+        bit_vector &operator=(const bit_vector &) = default;
+        bit_vector &operator=(bit_vector &&rhs) noexcept(std::is_nothrow_move_assignable<word_vector>::value)
+        {
+            words_ = mystl::move(rhs.words_);
+            size_ = rhs.size_;
+            rhs.clear();
+            return *this;
+        }
+
+        allocator_type get_allocator() const { return words_.get_allocator(); }
+
+        /*********************迭代器相关操作**************/
+        iterator begin() noexcept { return iterator(words_.data(), 0); }
+        const_iterator begin() const noexcept { return const_iterator(words_.data(), 0); }
+        iterator end() noexcept { return iterator(words_.data(), size_); }
+        const_iterator end() const noexcept { return const_iterator(words_.data(), size_); }
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+
+        /*********************容量相关操作**************/
+        bool empty() const noexcept { return size_ == 0; }
+        size_type size() const noexcept { return size_; }
+        size_type max_size() const noexcept { return words_.max_size(); }
+        size_type capacity() const noexcept { return words_.capacity() * bits_per_word; }
+        void reserve(size_type n) { words_.reserve(word_count(n)); }
+        void shrink_to_fit() { words_.shrink_to_fit(); }
+
+        /*********************访问元素相关操作**************/
+        reference operator[](size_type n)
+        {
+            MYSTL_DEBUG(n < size_);
+            return reference(words_.data() + n / bits_per_word, static_cast<unsigned>(n % bits_per_word));
+        }
+        const_reference operator[](size_type n) const
+        {
+            MYSTL_DEBUG(n < size_);
+            return test(n);
+        }
+        reference at(size_type n)
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size_), "bit_vector::at() subscript out of range");
+            return (*this)[n];
+        }
+        const_reference at(size_type n) const
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size_), "bit_vector::at() subscript out of range");
+            return (*this)[n];
+        }
+        reference front() { return (*this)[0]; }
+        const_reference front() const { return (*this)[0]; }
+        reference back() { return (*this)[size_ - 1]; }
+        const_reference back() const { return (*this)[size_ - 1]; }
+
+        bool test(size_type n) const noexcept
+        {
+            return (words_[n / bits_per_word] >> (n % bits_per_word)) & 1;
+        }
+
+        // 按字访问，最后一个字中超出 size() 的位为 0，通过 data() 修改时调用者要保持这一点
+        word_type *data() noexcept { return words_.data(); }
+        const word_type *data() const noexcept { return words_.data(); }
+        size_type num_words() const noexcept { return words_.size(); }
+
+        /*********************修改容器相关操作**************/
+        void push_back(bool value)
+        {
+            if (size_ % bits_per_word == 0)
+                words_.push_back(word_type(0));
+            if (value)
+                words_.back() |= word_type(1) << (size_ % bits_per_word);
+            ++size_;
+        }
+        void pop_back() noexcept
+        {
+            MYSTL_DEBUG(!empty());
+            --size_;
+            if (size_ % bits_per_word == 0)
+                words_.pop_back();
+            else
+                words_.back() &= ~(word_type(1) << (size_ % bits_per_word));
+        }
+        void resize(size_type n, bool value = false);
+        void clear() noexcept
+        {
+            words_.clear();
+            size_ = 0;
+        }
+        void swap(bit_vector &rhs) noexcept
+        {
+            words_.swap(rhs.words_);
+            mystl::swap(size_, rhs.size_);
+        }
+
+        // 单个位
+        bit_vector &set(size_type n, bool value = true)
+        {
+            (*this)[n] = value;
+            return *this;
+        }
+        bit_vector &reset(size_type n)
+        {
+            (*this)[n] = false;
+            return *this;
+        }
+        bit_vector &flip(size_type n)
+        {
+            (*this)[n].flip();
+            return *this;
+        }
+        // 全部的位
+        bit_vector &set() noexcept;
+        bit_vector &reset() noexcept;
+        bit_vector &flip() noexcept;
+
+        /*********************按字处理的操作**************/
+        size_type count() const noexcept { return mystl::count_words(words_.data(), words_.size()); }
+        bool any() const noexcept;
+        bool none() const noexcept { return !any(); }
+        bool all() const noexcept { return count() == size_; }
+
+        size_type find_first() const noexcept { return find_from(0); }
+        // pos 之后（不含 pos）的第一个 1
+        size_type find_next(size_type pos) const noexcept
+        {
+            return pos >= size_ || pos + 1 == size_ ? npos : find_from(pos + 1);
+        }
+
+        // 按下标从小到大对每个 1 调用 f(pos)，逐字取出最低位的 1，比反复 find_next 少一次取字与屏蔽
+        template <class Function>
+        void for_each_set(Function f) const
+        {
+            for (size_type i = 0; i < words_.size(); ++i)
+            {
+                for (word_type w = words_[i]; w != 0; w &= w - 1)
+                    f(i * bits_per_word + mystl::countr_zero64(w));
+            }
+        }
+
+        bit_vector &operator&=(const bit_vector &rhs) noexcept { return apply<word_and>(rhs); }
+        bit_vector &operator|=(const bit_vector &rhs) noexcept { return apply<word_or>(rhs); }
+        bit_vector &operator^=(const bit_vector &rhs) noexcept { return apply<word_xor>(rhs); }
+        // *this &= ~rhs
+        bit_vector &and_not(const bit_vector &rhs) noexcept { return apply<word_and_not>(rhs); }
+
+        size_type count_and(const bit_vector &rhs) const noexcept
+        {
+            MYSTL_DEBUG(size_ == rhs.size_);
+            return mystl::count_and_words(words_.data(), rhs.words_.data(), words_.size());
+        }
+
+        bool operator==(const bit_vector &rhs) const noexcept
+        {
+            return size_ == rhs.size_ && mystl::equal(words_.begin(), words_.end(), rhs.words_.begin());
+        }
+        bool operator!=(const bit_vector &rhs) const noexcept { return !(*this == rhs); }
+
+    private:
+        static size_type word_count(size_type bits) noexcept
+        {
+            return (bits + bits_per_word - 1) / bits_per_word;
+        }
+        // 把最后一个字中超出 size() 的位清零
+        void clear_tail() noexcept
+        {
+            if (size_ % bits_per_word != 0)
+                words_.back() &= (word_type(1) << (size_ % bits_per_word)) - 1;
+        }
+        size_type find_from(size_type pos) const noexcept;
+
+        template <class Op>
+        bit_vector &apply(const bit_vector &rhs) noexcept
+        {
+            MYSTL_DEBUG(size_ == rhs.size_);
+            mystl::bitwise_words<Op>(words_.data(), rhs.words_.data(), words_.size());
+            return *this;
+        }
+    };
+
+    /*****************************************************************************************/
+    // 扩大时新增的位为 value
+    template <class Alloc>
+    void bit_vector<Alloc>::resize(size_type n, bool value)
+    {
+        if (n > size_ && value && size_ % bits_per_word != 0)
+            words_.back() |= ~word_type(0) << (size_ % bits_per_word);
+        words_.resize(word_count(n), value ? ~word_type(0) : word_type(0));
+        size_ = n;
+        clear_tail();
+    }
+
+    template <class Alloc>
+    bit_vector<Alloc> &bit_vector<Alloc>::set() noexcept
+    {
+        mystl::fill(words_.begin(), words_.end(), ~word_type(0));
+        clear_tail();
+        return *this;
+    }
+
+    template <class Alloc>
+    bit_vector<Alloc> &bit_vector<Alloc>::reset() noexcept
+    {
+        mystl::fill(words_.begin(), words_.end(), word_type(0));
+        return *this;
+    }
+
+    template <class Alloc>
+    bit_vector<Alloc> &bit_vector<Alloc>::flip() noexcept
+    {
+        for (auto &w : words_)
+            w = ~w;
+        clear_tail();
+        return *this;
+    }
+
+    template <class Alloc>
+    bool bit_vector<Alloc>::any() const noexcept
+    {
+        for (auto w : words_)
+        {
+            if (w != 0)
+                return true;
+        }
+        return false;
+    }
+
+    // 从 pos 开始（含 pos）的第一个 1：先屏蔽 pos 所在字中较低的位，之后整字跳过 0
+    template <class Alloc>
+    typename bit_vector<Alloc>::size_type
+    bit_vector<Alloc>::find_from(size_type pos) const noexcept
+    {
+        size_type i = pos / bits_per_word;
+        const size_type n = words_.size();
+        if (i >= n)
+            return npos;
+        word_type w = words_[i] & (~word_type(0) << (pos % bits_per_word));
+        while (w == 0)
+        {
+            if (++i == n)
+                return npos;
+            w = words_[i];
+        }
+        return i * bits_per_word + mystl::countr_zero64(w);
+    }
+
+    // 重载比较操作符与 swap
+    template <class Alloc>
+    bit_vector<Alloc> operator&(bit_vector<Alloc> lhs, const bit_vector<Alloc> &rhs)
+    {
+        lhs &= rhs;
+        return lhs;
+    }
+    template <class Alloc>
+    bit_vector<Alloc> operator|(bit_vector<Alloc> lhs, const bit_vector<Alloc> &rhs)
+    {
+        lhs |= rhs;
+        return lhs;
+    }
+    template <class Alloc>
+    bit_vector<Alloc> operator^(bit_vector<Alloc> lhs, const bit_vector<Alloc> &rhs)
+    {
+        lhs ^= rhs;
+        return lhs;
+    }
+    template <class Alloc>
+    void swap(bit_vector<Alloc> &lhs, bit_vector<Alloc> &rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    template <class Alloc>
+    struct is_trivially_relocatable<bit_vector<Alloc>>
+        : is_trivially_relocatable<typename bit_vector<Alloc>::word_vector>
+    {
+    };
+
+    namespace pmr
+    {
+        using bit_vector = mystl::bit_vector<polymorphic_allocator<uint64_t>>;
+    }
+} // namespace mystl
+#endif // !MYTINYSTL_BIT_VECTOR_H_
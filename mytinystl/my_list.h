@@ -1,33 +1,40 @@
-#ifndef MYTINYSTL_MY_STRING_H_
-#define MYTINYSTL_MY_STRING_H_
+#ifndef MYTINYSTL_MY_LIST_H_
+#define MYTINYSTL_MY_LIST_H_
+
+#include <initializer_list>
 
 #include "base/iterator.h"
 #include "base/memory.h"
+#include "base/allocator_traits.h"
+#include "base/memory_resource.h"
 #include "base/util.h"
 #include "base/exceptdef.h"
+#include "base/functional.h"
 
 namespace mystl
 {
-    // 结点
-    template <class T>
+    // 结点，前后结点的指针类型由配置器的 void_pointer 决定，
+    // 配置器使用 offset_ptr 时结点之间只保存偏移
+    template <class T, class VoidPtr = void *>
     struct list_node
     {
-        typedef list_node<T> *pointer;
+        typedef typename mystl::pointer_traits<VoidPtr>::template rebind<list_node> pointer;
         pointer prev;
         pointer next;
         T data;
     };
-    template <class T, class Ref, class Ptr>
+    // 迭代器只在进程内使用，保存原生的结点指针
+    template <class T, class Ref, class Ptr, class VoidPtr = void *>
     struct list_iterator
     {
-        typedef list_iterator<T, T &, T *> iterator;
-        typedef list_iterator<T, Ref, Ptr> self;
+        typedef list_iterator<T, T &, T *, VoidPtr> iterator;
+        typedef list_iterator<T, Ref, Ptr, VoidPtr> self;
 
         typedef bidirectional_iterator_tag iterator_category;
         typedef T value_type;
         typedef Ptr pointer;
         typedef Ref reference;
-        typedef list_node<T> *link_type;
+        typedef list_node<T, VoidPtr> *link_type;
         typedef size_t size_type;
         typedef ptrdiff_t difference_type;
 
@@ -37,7 +44,7 @@ namespace mystl
         list_iterator() {}
         list_iterator(const iterator &x) : node(x.node) {}
 
-        bool operator=(const self &x) const { return node == x.node; }
+        bool operator==(const self &x) const { return node == x.node; }
         bool operator!=(const self &x) const { return node != x.node; }
 
         reference operator*() const { return (*node).data; }
@@ -67,113 +74,184 @@ namespace mystl
         }
     };
     // list
-    template <class T>
-    class list
+    template <class T, class Alloc = mystl::allocator<T>>
+    class list : private mystl::allocator_holder<
+                     typename mystl::allocator_traits<Alloc>::template rebind_alloc<
+                         list_node<T, typename mystl::allocator_traits<Alloc>::void_pointer>>>
     {
-        typedef mystl::allocator<T> allocator_type;
-        typedef mystl::allocator<T> data_allocator;
-        typedef mystl::allocator<list_node<T>> node_allocator;
-
-        typedef typename allocator_type::value_type value_type;
-        typedef typename allocator_type::pointer pointer;
-        typedef typename allocator_type::const_pointer const_pointer;
-        typedef typename allocator_type::reference reference;
-        typedef typename allocator_type::const_reference;
-        typedef typename allocator_type::size_type size_type;
-        typedef typename allocator_type::difference_type difference_type;
-
-        typedef list_iterator<T, T &, T *> self;
-        typedef list_node<T> *list_node;
-        typedef list_node link_type;
-
-        typedef list_iterator<T, T &, T *> iterator;
-        typedef list_iterator<T, const T &, const T *> const_iterator;
+    public:
+        typedef Alloc allocator_type;
+        typedef mystl::allocator_traits<Alloc> alloc_traits;
+        typedef typename alloc_traits::void_pointer void_pointer;
+        typedef list_node<T, void_pointer> node_type;
+        typedef typename alloc_traits::template rebind_alloc<node_type> node_allocator;
+        typedef mystl::allocator_traits<node_allocator> node_traits;
+
+        typedef typename alloc_traits::value_type value_type;
+        typedef typename alloc_traits::pointer pointer;
+        typedef typename alloc_traits::const_pointer const_pointer;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef typename alloc_traits::size_type size_type;
+        typedef typename alloc_traits::difference_type difference_type;
+
+        typedef node_type *link_type;
+
+        typedef list_iterator<T, T &, T *, void_pointer> iterator;
+        typedef list_iterator<T, const T &, const T *, void_pointer> const_iterator;
         typedef typename mystl::reverse_iterator<iterator> reverse_iterator;
         typedef typename mystl::reverse_iterator<const_iterator> const_reverse_iterator;
 
     private:
-        link_type node_; //指向末尾结点
+        // 结点的配置器存放在基类中，空的配置器不占空间
+        typedef mystl::allocator_holder<node_allocator> alloc_base;
+
+        // 移动赋值能否直接接管对方的结点
+        static constexpr bool move_assign_steals =
+            node_traits::propagate_on_container_move_assignment::value ||
+            node_traits::is_always_equal::value;
+
+    private:
+        typename node_traits::pointer node_; //指向末尾结点，使用配置器的 pointer 以便放入共享内存
         size_type size_;
 
     public:
         // 构造、复制、移动、析构
         list()
+            : alloc_base()
+        {
+            fill_init(0, value_type());
+        }
+        explicit list(const allocator_type &alloc)
+            : alloc_base(node_allocator(alloc))
         {
             fill_init(0, value_type());
         }
-        explicit list(size_type n)
+        explicit list(size_type n, const allocator_type &alloc = allocator_type())
+            : alloc_base(node_allocator(alloc))
         {
             fill_init(n, value_type());
         }
-        list(size_type n, const T &value)
+        list(size_type n, const T &value, const allocator_type &alloc = allocator_type())
+            : alloc_base(node_allocator(alloc))
         {
             fill_init(n, value);
         }
 
         template <class Iter, typename std::enable_if<
                                   mystl::is_input_iterator<Iter>::value, int>::type = 0>
-        list(Iter first, Iter last)
+        list(Iter first, Iter last, const allocator_type &alloc = allocator_type())
+            : alloc_base(node_allocator(alloc))
         {
             copy_init(first, last);
         }
-        list(std::initializer_list<T> ilist)
+        list(std::initializer_list<T> ilist, const allocator_type &alloc = allocator_type())
+            : alloc_base(node_allocator(alloc))
         {
             copy_init(ilist.begin(), ilist.end());
         }
-        list(cosnt list &rhs)
+        // 复制构造，新容器的配置器由 select_on_container_copy_construction 决定
+        list(const list &rhs)
+            : alloc_base(node_traits::select_on_container_copy_construction(rhs.node_alloc()))
         {
             copy_init(rhs.begin(), rhs.end());
         }
-        list(list &&rhs) noexcept
-            : node_(rhs.node_), size_(rhs.size_)
+        list(const list &rhs, const allocator_type &alloc)
+            : alloc_base(node_allocator(alloc))
         {
-            rhs.node_ = nullptr;
-            rhs.size_ = 0;
+            copy_init(rhs.begin(), rhs.end());
+        }
+        // 尾结点在堆上，移动后 rhs 换上新建的空尾结点，仍然是可以使用的空 list，
+        // 因此移动构造需要分配一个结点，不是 noexcept 的
+        list(list &&rhs)
+            : alloc_base(rhs.node_alloc())
+        {
+            fill_init(0, value_type());
+            mystl::swap(node_, rhs.node_);
+            mystl::swap(size_, rhs.size_);
         }
         list &operator=(const list &rhs)
         {
-            if (!this != &rhs)
+            if (this != &rhs)
             {
+                // 需要传播且配置器不同时，旧结点必须用旧的配置器释放，再用新的配置器重建
+                if (node_traits::propagate_on_container_copy_assignment::value &&
+                    !(node_alloc() == rhs.node_alloc()))
+                {
+                    release_all();
+                    node_traits::copy_assign(node_alloc(), rhs.node_alloc());
+                    copy_init(rhs.begin(), rhs.end());
+                    return *this;
+                }
+                node_traits::copy_assign(node_alloc(), rhs.node_alloc());
                 assign(rhs.begin(), rhs.end());
             }
             return *this;
         }
-        list &operator=(list &&rhs) noexcept
+        // 配置器相等时与 rhs 交换尾结点；配置器会传播但不相等时接管 rhs 的结点，
+        // 再用 rhs 的配置器为它新建空的尾结点；否则逐个移动元素。rhs 之后都是空 list
+        list &operator=(list &&rhs) noexcept(node_traits::is_always_equal::value)
         {
-            clear();
-            splice(end(), rhs);
+            if (this == &rhs)
+                return *this;
+            if (node_alloc() == rhs.node_alloc())
+            {
+                clear();
+                node_traits::move_assign(node_alloc(), rhs.node_alloc());
+                mystl::swap(node_, rhs.node_);
+                mystl::swap(size_, rhs.size_);
+            }
+            else if (move_assign_steals)
+            {
+                link_type empty = node_traits::allocate(rhs.node_alloc(), 1);
+                empty->prev = empty;
+                empty->next = empty;
+                release_all();
+                node_traits::move_assign(node_alloc(), rhs.node_alloc());
+                node_ = rhs.node_;
+                size_ = rhs.size_;
+                rhs.node_ = empty;
+                rhs.size_ = 0;
+            }
+            else
+            {
+                clear();
+                for (auto it = rhs.begin(); it != rhs.end(); ++it)
+                    emplace_back(mystl::move(*it));
+                rhs.clear();
+            }
             return *this;
         }
         list &operator=(std::initializer_list<T> ilist)
         {
-            list tmp(ilist.begin(), ilist.end());
+            list tmp(ilist.begin(), ilist.end(), get_allocator());
             swap(tmp);
             return *this;
         }
         ~list()
         {
-            if (node_)
-            {
-                clear();
-                node_allocator::deallocate(node_);
-            }
+            release_all();
+        }
+        allocator_type get_allocator() const
+        {
+            return allocator_type(node_alloc());
         }
         // 迭代器
         iterator begin() noexcept
         {
-            return node_->next;
+            return iterator(node_->next);
         }
         const_iterator begin() const noexcept
         {
-            return node_->next;
+            return const_iterator(node_->next);
         }
         iterator end() noexcept
         {
-            return node_;
+            return iterator(node_);
         }
         const_iterator end() const noexcept
         {
-            return node_;
+            return const_iterator(node_);
         }
         reverse_iterator rbegin() noexcept
         {
@@ -261,7 +339,7 @@ namespace mystl
             emplace_front(mystl::move(value));
         }
         void push_back(const value_type &value);
-        void push_front(value_type &&value)
+        void push_back(value_type &&value)
         {
             emplace_back(mystl::move(value));
         }
@@ -277,8 +355,23 @@ namespace mystl
         void resize(size_type new_size) { resize(new_size, value_type()); }
         void resize(size_type new_size, const value_type &value);
 
+        // splice / assign
+        void splice(const_iterator pos, list &other);
+        template <class Iter, typename std::enable_if<
+                                  mystl::is_input_iterator<Iter>::value, int>::type = 0>
+        void assign(Iter first, Iter last)
+        {
+            clear();
+            for (; first != last; ++first)
+                emplace_back(*first);
+        }
+
         void swap(list &rhs) noexcept
         {
+            // 配置器不传播时，只有相等的配置器才能交换结点
+            MYSTL_DEBUG(node_traits::propagate_on_container_swap::value ||
+                        node_alloc() == rhs.node_alloc());
+            node_traits::swap(node_alloc(), rhs.node_alloc());
             mystl::swap(node_, rhs.node_);
             mystl::swap(size_, rhs.size_);
         }
@@ -288,22 +381,42 @@ namespace mystl
         {
             list_sort(begin(), end(), size(), mystl::less<T>());
         }
-        template <class>
+        template <class Compared>
         void sort(Compared comp)
         {
             list_sort(begin(), end(), size(), comp);
         }
 
     private:
+        // 取得结点的配置器
+        node_allocator &node_alloc() noexcept { return alloc_base::get(); }
+        const node_allocator &node_alloc() const noexcept { return alloc_base::get(); }
+
+        // 销毁所有结点并释放尾结点
+        void release_all() noexcept
+        {
+            if (node_)
+            {
+                clear();
+                node_traits::deallocate(node_alloc(), node_, 1);
+                node_ = nullptr;
+            }
+        }
+
+        void fill_init(size_type n, const value_type &value);
+        template <class Iter>
+        void copy_init(Iter first, Iter last);
         template <class... Args>
         link_type create_node(Args &&...args);
         void destroy_node(link_type p);
+        void link_nodes(link_type pos, link_type first, link_type last);
+        void unlink_nodes(link_type first, link_type last);
         template <class Compared>
         iterator list_sort(iterator first, iterator last, size_type n, Compared comp);
     };
-    template <class T>
+    template <class T, class Alloc>
     template <class... Args>
-    void list<T>::emplace_front(Args &&...args)
+    void list<T, Alloc>::emplace_front(Args &&...args)
     {
         auto link_node = create_node(mystl::forward<Args>(args)...);
         link_node->next = node_->next;
@@ -312,9 +425,9 @@ namespace mystl
         link_node->prev = node_;
         ++size_;
     }
-    template <class T>
+    template <class T, class Alloc>
     template <class... Args>
-    void list<T>::emplace_back(Args &&...args)
+    void list<T, Alloc>::emplace_back(Args &&...args)
     {
         auto link_node = create_node(mystl::forward<Args>(args)...);
         link_node->next = node_;
@@ -323,45 +436,45 @@ namespace mystl
         link_node->prev->next = link_node;
         ++size_;
     }
-    template <class T>
+    // 在pos之前构造元素
+    template <class T, class Alloc>
     template <class... Args>
-    typename list<T>::iterator list<T>::emplace(const_iterator pos, Args &&...args)
+    typename list<T, Alloc>::iterator list<T, Alloc>::emplace(const_iterator pos, Args &&...args)
     {
         auto link_node = create_node(mystl::forward<Args>(args)...);
-        auto cur = pos->node;
-        link_node->next = cur->next;
-        link_node->prev = cur;
+        auto cur = pos.node;
+        link_node->next = cur;
+        link_node->prev = cur->prev;
         link_node->next->prev = link_node;
         link_node->prev->next = link_node;
         ++size_;
-        return static_cast<iterator>(link_node);
+        return iterator(link_node);
     }
-    template <class T>
-    typename list<T>::iterator list<T>::insert(const_iterator pos, const value_type &value)
+    // 在pos之前插入元素
+    template <class T, class Alloc>
+    typename list<T, Alloc>::iterator list<T, Alloc>::insert(const_iterator pos, const value_type &value)
     {
         auto link_node = create_node(value);
-        auto cur = pos->node;
-        link_node->next = cur->next;
-        link_node->prev = cur;
+        auto cur = pos.node;
+        link_node->next = cur;
+        link_node->prev = cur->prev;
         link_node->next->prev = link_node;
         link_node->prev->next = link_node;
         ++size_;
-        return static_cast<iterator>(link_node);
+        return iterator(link_node);
     }
-    template <class T>
-    typename list<T>::iterator list<T>::insert(const_iterator pos, size_type n, const value_type &value)
+    template <class T, class Alloc>
+    typename list<T, Alloc>::iterator list<T, Alloc>::insert(const_iterator pos, size_type n, const value_type &value)
     {
         if (n == 0)
-            return static_cast<iterator>(pos->node);
-        for (int i = 0; i < n; ++i)
-        {
-            auto tmp = insert(pos, value);
-            pos->node = tmp->node;
-        }
-        return static_cast<iterator>(pos->node);
+            return iterator(pos.node);
+        auto r = insert(pos, value);
+        for (size_type i = 1; i < n; ++i)
+            insert(pos, value);
+        return r;
     }
-    template <class T>
-    void list<T>::push_front(const value_type &value)
+    template <class T, class Alloc>
+    void list<T, Alloc>::push_front(const value_type &value)
     {
         auto link_node = create_node(value);
         link_node->next = node_->next;
@@ -370,8 +483,8 @@ namespace mystl
         link_node->next->prev = link_node;
         ++size_;
     }
-    template <class T>
-    void list<T>::push_back(const value_type &value)
+    template <class T, class Alloc>
+    void list<T, Alloc>::push_back(const value_type &value)
     {
         auto link_node = create_node(value);
         link_node->next = node_;
@@ -380,8 +493,8 @@ namespace mystl
         link_node->prev->next = link_node;
         ++size_;
     }
-    template <class T>
-    void list<T>::pop_front()
+    template <class T, class Alloc>
+    void list<T, Alloc>::pop_front()
     {
         MYSTL_DEBUG(!empty());
         auto cur = node_->next;
@@ -390,8 +503,8 @@ namespace mystl
         destroy_node(cur);
         --size_;
     }
-    template <class T>
-    void list<T>::pop_back()
+    template <class T, class Alloc>
+    void list<T, Alloc>::pop_back()
     {
         MYSTL_DEBUG(!empty());
         auto cur = node_->prev;
@@ -402,41 +515,42 @@ namespace mystl
     }
 
     // 删除pos
-    template <class T>
-    typename list<T>::iterator list<T>::erase(const_iterator pos)
+    template <class T, class Alloc>
+    typename list<T, Alloc>::iterator list<T, Alloc>::erase(const_iterator pos)
     {
         MYSTL_DEBUG(pos != cend());
-        auto cur = pos.node_;
+        auto cur = pos.node;
         auto res = cur->next;
         cur->prev->next = cur->next;
         cur->next->prev = cur->prev;
         destroy_node(cur);
         --size_;
-        return static_cast<iterator>(res);
+        return iterator(res);
     }
     //删除[first,last)
-    template <class T>
-    typename list<T>::iterator
-    list<T>::erase(const_iterator first, const_iterator last)
+    template <class T, class Alloc>
+    typename list<T, Alloc>::iterator
+    list<T, Alloc>::erase(const_iterator first, const_iterator last)
     {
         if (first != last)
         {
-            auto cur1 = first.node_;
-            auto cur2 = last.node_;
+            auto cur1 = first.node;
+            auto cur2 = last.node;
             cur1->prev->next = cur2;
             cur2->prev = cur1->prev;
             while (cur1 != cur2)
             {
                 auto tmp = cur1->next;
                 destroy_node(cur1);
+                --size_;
                 cur1 = tmp;
             }
         }
-        return static_cast<iterator>(last.node_);
+        return iterator(last.node);
     }
     // 清空：clear()
-    template <class T>
-    void list<T>::clear()
+    template <class T, class Alloc>
+    void list<T, Alloc>::clear()
     {
         if (size_ != 0)
         {
@@ -447,76 +561,226 @@ namespace mystl
             }
             node_->next = node_;
             node_->prev = node_;
+            size_ = 0;
         }
     }
     // resize
-    template <class T>
-    void list<T>::resize(size_type size, const value_type &value)
+    template <class T, class Alloc>
+    void list<T, Alloc>::resize(size_type size, const value_type &value)
     {
-        if (size_ = size)
+        if (size_ == size)
         {
             return;
         }
         else if (size_ < size)
         {
-            insert(node_, size - size_, value);
+            insert(end(), size - size_, value);
         }
         else
         {
             auto item = begin();
-            for (int i = 0; i < size; ++item.++i)
+            for (size_type i = 0; i < size; ++item, ++i)
                 ;
-            erase(item, node_);
+            erase(item, end());
         }
     }
-    // splice
+    // splice：将other的全部结点接到pos之前
+    template <class T, class Alloc>
+    void list<T, Alloc>::splice(const_iterator pos, list &other)
+    {
+        MYSTL_DEBUG(this != &other);
+        if (other.node_ == nullptr || other.empty())
+            return;
+        THROW_LENGTH_ERROR_IF(size_ > max_size() - other.size_, "list<T>'s size too big");
+        auto first = other.node_->next;
+        auto last = other.node_->prev;
+        other.node_->next = other.node_;
+        other.node_->prev = other.node_;
+
+        auto cur = pos.node;
+        first->prev = cur->prev;
+        cur->prev->next = first;
+        last->next = cur;
+        cur->prev = last;
+
+        size_ += other.size_;
+        other.size_ = 0;
+    }
 
     /****************************辅助函数*********************************/
+    // 初始化：创建尾结点并插入n个value
+    template <class T, class Alloc>
+    void list<T, Alloc>::fill_init(size_type n, const value_type &value)
+    {
+        node_ = node_traits::allocate(node_alloc(), 1);
+        node_->prev = node_;
+        node_->next = node_;
+        size_ = 0;
+        try
+        {
+            for (; n > 0; --n)
+                push_back(value);
+        }
+        catch (...)
+        {
+            clear();
+            node_traits::deallocate(node_alloc(), node_, 1);
+            node_ = nullptr;
+            throw;
+        }
+    }
+    // 初始化：以[first,last)初始化
+    template <class T, class Alloc>
+    template <class Iter>
+    void list<T, Alloc>::copy_init(Iter first, Iter last)
+    {
+        node_ = node_traits::allocate(node_alloc(), 1);
+        node_->prev = node_;
+        node_->next = node_;
+        size_ = 0;
+        try
+        {
+            for (; first != last; ++first)
+                emplace_back(*first);
+        }
+        catch (...)
+        {
+            clear();
+            node_traits::deallocate(node_alloc(), node_, 1);
+            node_ = nullptr;
+            throw;
+        }
+    }
     // 创建一个结点
-    template <class T>
+    template <class T, class Alloc>
     template <class... Args>
-    typename list<T>::link_type list<T>::create_node(Args &&...args)
+    typename list<T, Alloc>::link_type list<T, Alloc>::create_node(Args &&...args)
     {
-        link_type p = node_allocator::allocate(1);
+        link_type p = node_traits::allocate(node_alloc(), 1);
         try
         {
-            data_allocator::construct(mystl::address_of(p->data),
-                                      mystl::forward<Args>(args)...);
+            node_traits::construct(node_alloc(), mystl::address_of(p->data),
+                                   mystl::forward<Args>(args)...);
             p->prev = nullptr;
             p->next = nullptr;
         }
         catch (...)
         {
-            mode_allocator::dealocate(p);
+            node_traits::deallocate(node_alloc(), p, 1);
             throw;
         }
         return p;
     }
     // 销毁结点
-    template <class T>
-    void list<T>::destroy_node(link_type p)
+    template <class T, class Alloc>
+    void list<T, Alloc>::destroy_node(link_type p)
     {
-        data_allocator::destroy(mystl::address_of(p->data));
-        node_allocator::deallocate(p);
+        node_traits::destroy(node_alloc(), mystl::address_of(p->data));
+        node_traits::deallocate(node_alloc(), p, 1);
     }
-    // 排序
-    template <class T>
+    // 排序：归并排序，返回排序后的起始位置
+    template <class T, class Alloc>
     template <class Compared>
-    typename list<T>::iterator
-    list<T>::list_sort(iterator left, iterator right, size_type n, Compared comp)
+    typename list<T, Alloc>::iterator
+    list<T, Alloc>::list_sort(iterator f1, iterator l2, size_type n, Compared comp)
     {
         if (n < 2)
-            return left;
+            return f1;
         if (n == 2)
         {
-            if (comp(*--right, *left))
+            if (comp(*--l2, *f1))
+            {
+                auto ln = l2.node;
+                unlink_nodes(ln, ln);
+                link_nodes(f1.node, ln, ln);
+                return l2;
+            }
+            return f1;
+        }
+        const auto n2 = n / 2;
+        auto l1 = f1;
+        mystl::advance(l1, n2);
+        auto result = f1 = list_sort(f1, l1, n2, comp);
+        auto f2 = l1 = list_sort(l1, l2, n - n2, comp);
+
+        // 把后半段中较小的一段区间移到f1之前
+        if (comp(*f2, *f1))
+        {
+            auto m = f2;
+            ++m;
+            for (; m != l2 && comp(*m, *f1); ++m)
+                ;
+            auto f = f2.node;
+            auto l = m.node->prev;
+            result = f2;
+            l1 = f2 = m;
+            unlink_nodes(f, l);
+            m = f1;
+            ++m;
+            link_nodes(f1.node, f, l);
+            f1 = m;
+        }
+        else
+        {
+            ++f1;
+        }
+        // 合并剩余的两段区间
+        while (f1 != l1 && f2 != l2)
+        {
+            if (comp(*f2, *f1))
             {
-                auto ln = right.node_;
-                ln->prev->next = ln->next;
-                ln->next->prev = ln->prev;
+                auto m = f2;
+                ++m;
+                for (; m != l2 && comp(*m, *f1); ++m)
+                    ;
+                auto f = f2.node;
+                auto l = m.node->prev;
+                if (l1 == f2)
+                    l1 = m;
+                f2 = m;
+                unlink_nodes(f, l);
+                m = f1;
+                ++m;
+                link_nodes(f1.node, f, l);
+                f1 = m;
+            }
+            else
+            {
+                ++f1;
             }
         }
+        return result;
+    }
+    // 把[first, last]接到pos之前
+    template <class T, class Alloc>
+    void list<T, Alloc>::link_nodes(link_type pos, link_type first, link_type last)
+    {
+        pos->prev->next = first;
+        first->prev = pos->prev;
+        pos->prev = last;
+        last->next = pos;
+    }
+    // 把[first, last]从链表中摘下
+    template <class T, class Alloc>
+    void list<T, Alloc>::unlink_nodes(link_type first, link_type last)
+    {
+        first->prev->next = last->next;
+        last->next->prev = first->prev;
+    }
+
+    // 哨兵结点也在堆上，没有结点指向 list 对象本身，结点配置器和指针都能按字节搬移时 list 也可以
+    template <class T, class Alloc>
+    struct is_trivially_relocatable<list<T, Alloc>>
+        : std::integral_constant<bool, is_trivially_relocatable<typename list<T, Alloc>::node_allocator>::value &&
+                                           is_trivially_relocatable<typename list<T, Alloc>::node_traits::pointer>::value>
+    {
+    };
+
+    namespace pmr
+    {
+        template <class T>
+        using list = mystl::list<T, polymorphic_allocator<T>>;
     }
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,388 @@
+#ifndef MYTINYSTL_SMALL_VECTOR_H_
+#define MYTINYSTL_SMALL_VECTOR_H_
+
+// 这个头文件包含模板类 small_vector，元素不超过 N 个时放在对象内部的缓冲区中，不访问堆
+// small_vector<T, N> 就是使用 small_vector_allocator 的 vector，公有接口与 vector 相同：
+//   small_vector_allocator 持有内部缓冲区的地址，缓冲区空闲且请求不超过 N 个时直接交出缓冲区，
+//   否则转给 Alloc；vector 扩容、收缩的代码不需要改动，超过 N 个时自然搬到堆上
+// 移动构造、移动赋值和 swap：元素在堆上且 Alloc 可以传播或相等时直接接管缓冲区（连同 Alloc），
+//   否则只能逐个移动元素
+//   例：mystl::small_vector<int, 8> v;   // 前 8 个元素不分配内存
+// 不要把 small_vector 当作 vector 的引用来做交换或移动赋值，内部缓冲区不能被另一个对象接管
+// vector 可能指向 small_vector 自身的缓冲区，small_vector 不能按字节搬移（is_trivially_relocatable 为 false）
+
+#include <initializer_list>
+
+#include "my_vector.h"
+
+namespace mystl
+{
+    // 内部缓冲区，作为 small_vector 的第一个基类，先于 vector 构造、后于 vector 析构
+    template <class T, size_t N>
+    struct small_vector_storage
+    {
+        // 名字避开 vector 的成员，small_vector 同时继承两者
+        alignas(T) unsigned char inline_buffer_[N * sizeof(T)];
+        bool inline_in_use_; // 缓冲区是否已经交给了 vector
+
+        small_vector_storage() noexcept : inline_in_use_(false) {}
+        small_vector_storage(const small_vector_storage &) = delete;
+        small_vector_storage &operator=(const small_vector_storage &) = delete;
+
+        T *inline_data() noexcept { return reinterpret_cast<T *>(inline_buffer_); }
+        const T *inline_data() const noexcept { return reinterpret_cast<const T *>(inline_buffer_); }
+    };
+
+    // --------------------------------------------------------------------------------------
+    // 模板类：small_vector_allocator
+    // 只有指向同一个缓冲区的配置器才相等，容器之间不传播；
+    // rebind 得到的配置器和 select_on_container_copy_construction 的结果不带缓冲区，只使用 Alloc
+    template <class T, size_t N, class Alloc = mystl::allocator<T>>
+    class small_vector_allocator : private mystl::allocator_holder<Alloc>
+    {
+    private:
+        typedef mystl::allocator_holder<Alloc> alloc_base;
+        typedef mystl::allocator_traits<Alloc> base_traits;
+
+    public:
+        typedef T value_type;
+        typedef T *pointer;
+        typedef const T *const_pointer;
+        typedef T &reference;
+        typedef const T &const_reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+        typedef small_vector_storage<T, N> storage_type;
+
+        template <class U>
+        struct rebind
+        {
+            typedef small_vector_allocator<U, N, typename base_traits::template rebind_alloc<U>> other;
+        };
+
+        typedef std::false_type propagate_on_container_copy_assignment;
+        typedef std::false_type propagate_on_container_move_assignment;
+        typedef std::false_type propagate_on_container_swap;
+        typedef std::false_type is_always_equal;
+
+        static_assert(std::is_same<typename base_traits::pointer, T *>::value,
+                      "small_vector needs an allocator with raw pointers");
+
+    private:
+        storage_type *storage_;
+
+    public:
+        small_vector_allocator() noexcept : alloc_base(), storage_(nullptr) {}
+        explicit small_vector_allocator(storage_type *storage, const Alloc &a = Alloc())
+            : alloc_base(a), storage_(storage)
+        {
+        }
+        template <class U, class A>
+        small_vector_allocator(const small_vector_allocator<U, N, A> &other)
+            : alloc_base(Alloc(other.base())), storage_(nullptr)
+        {
+        }
+
+        pointer allocate(size_type n)
+        {
+            if (inline_available(n))
+            {
+                storage_->inline_in_use_ = true;
+                return storage_->inline_data();
+            }
+            return base_traits::allocate(this->get(), n);
+        }
+        // 交出内部缓冲区时容量就是 N
+        allocation_result<pointer, size_type> allocate_at_least(size_type n)
+        {
+            if (inline_available(n))
+            {
+                storage_->inline_in_use_ = true;
+                return {storage_->inline_data(), N};
+            }
+            return base_traits::allocate_at_least(this->get(), n);
+        }
+        void deallocate(pointer ptr, size_type n)
+        {
+            if (owns(ptr))
+            {
+                storage_->inline_in_use_ = false;
+                return;
+            }
+            base_traits::deallocate(this->get(), ptr, n);
+        }
+
+        small_vector_allocator select_on_container_copy_construction() const
+        {
+            return small_vector_allocator(nullptr, base_traits::select_on_container_copy_construction(base()));
+        }
+
+        bool owns(const T *ptr) const noexcept
+        {
+            return storage_ != nullptr && ptr == storage_->inline_data();
+        }
+        storage_type *storage() const noexcept { return storage_; }
+        Alloc &base() noexcept { return this->get(); }
+        const Alloc &base() const noexcept { return this->get(); }
+
+    private:
+        bool inline_available(size_type n) const noexcept
+        {
+            return storage_ != nullptr && n <= N && !storage_->inline_in_use_;
+        }
+    };
+
+    template <class T, class U, size_t N, class A1, class A2>
+    bool operator==(const small_vector_allocator<T, N, A1> &lhs,
+                    const small_vector_allocator<U, N, A2> &rhs)
+    {
+        return static_cast<const void *>(lhs.storage()) == static_cast<const void *>(rhs.storage()) &&
+               lhs.base() == rhs.base();
+    }
+    template <class T, class U, size_t N, class A1, class A2>
+    bool operator!=(const small_vector_allocator<T, N, A1> &lhs,
+                    const small_vector_allocator<U, N, A2> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    // --------------------------------------------------------------------------------------
+    // 模板类：small_vector
+    // 构造时就把内部缓冲区交给 vector，容量至少为 N；
+    // 不超过 N 个元素的 small_vector 在构造、析构时都不会访问堆
+    template <class T, size_t N, class Alloc = mystl::allocator<T>>
+    class small_vector : private small_vector_storage<T, N>,
+                         public mystl::vector<T, small_vector_allocator<T, N, Alloc>>
+    {
+        static_assert(N > 0, "small_vector needs at least one inline element");
+
+    private:
+        typedef small_vector_storage<T, N> storage_base;
+        typedef mystl::vector<T, small_vector_allocator<T, N, Alloc>> base;
+
+    public:
+        typedef typename base::allocator_type allocator_type;
+        typedef typename base::value_type value_type;
+        typedef typename base::size_type size_type;
+        typedef typename base::iterator iterator;
+        typedef typename base::const_iterator const_iterator;
+
+        static constexpr size_type inline_capacity = N;
+
+    public:
+        small_vector() noexcept
+            : storage_base(), base(make_alloc(Alloc()))
+        {
+            reset_inline();
+        }
+        explicit small_vector(const Alloc &alloc) noexcept
+            : storage_base(), base(make_alloc(alloc))
+        {
+            reset_inline();
+        }
+        explicit small_vector(size_type n, const Alloc &alloc = Alloc())
+            : storage_base(), base(make_alloc(alloc))
+        {
+            reset_inline();
+            fill_init(n, value_type());
+        }
+        small_vector(size_type n, const value_type &value, const Alloc &alloc = Alloc())
+            : storage_base(), base(make_alloc(alloc))
+        {
+            reset_inline();
+            fill_init(n, value);
+        }
+        template <class Iter, typename std::enable_if<
+                                  mystl::is_input_iterator<Iter>::value, int>::type = 0>
+        small_vector(Iter first, Iter last, const Alloc &alloc = Alloc())
+            : storage_base(), base(make_alloc(alloc))
+        {
+            reset_inline();
+            range_init(first, last);
+        }
+        small_vector(std::initializer_list<value_type> ilist, const Alloc &alloc = Alloc())
+            : storage_base(), base(make_alloc(alloc))
+        {
+            reset_inline();
+            range_init(ilist.begin(), ilist.end());
+        }
+        small_vector(const small_vector &rhs)
+            : storage_base(),
+              base(make_alloc(mystl::allocator_traits<Alloc>::select_on_container_copy_construction(
+                  rhs.get_allocator().base())))
+        {
+            reset_inline();
+            range_init(rhs.begin(), rhs.end());
+        }
+        small_vector(small_vector &&rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+            : storage_base(), base(make_alloc(rhs.get_allocator().base()))
+        {
+            reset_inline();
+            take(rhs);
+        }
+
+        small_vector &operator=(const small_vector &rhs)
+        {
+            base::operator=(rhs);
+            return *this;
+        }
+        // Alloc 不传播且不一定相等时，可能要为逐个移动的元素分配空间
+        small_vector &operator=(small_vector &&rhs) noexcept(
+            std::is_nothrow_move_constructible<T>::value &&
+            (mystl::allocator_traits<Alloc>::propagate_on_container_move_assignment::value ||
+             mystl::allocator_traits<Alloc>::is_always_equal::value));
+        // 不经过临时 vector，元素不超过 N 个时仍留在内部缓冲区
+        small_vector &operator=(std::initializer_list<value_type> ilist)
+        {
+            this->clear();
+            this->insert(this->end(), ilist.begin(), ilist.end());
+            return *this;
+        }
+
+        // 元素是否在内部缓冲区中
+        bool is_inline() const noexcept
+        {
+            return this->begin_ == storage_base::inline_data();
+        }
+
+        // 元素能放进内部缓冲区时搬回去，否则与 vector 相同
+        void shrink_to_fit();
+        void swap(small_vector &rhs);
+
+    private:
+        allocator_type make_alloc(const Alloc &alloc) noexcept
+        {
+            return allocator_type(static_cast<storage_base *>(this), alloc);
+        }
+        // 只在 vector 不持有任何空间时调用：把内部缓冲区交给 vector
+        void reset_inline() noexcept
+        {
+            storage_base::inline_in_use_ = true;
+            this->begin_ = this->end_ = storage_base::inline_data();
+            this->capacity_ = this->begin_ + N;
+        }
+        // 构造函数中使用：空间不够时先换到堆上，再直接构造元素
+        void fill_init(size_type n, const value_type &value)
+        {
+            this->reserve(n);
+            this->end_ = mystl::uninitialized_fill_n(this->begin(), n, value);
+        }
+        template <class Iter>
+        void range_init(Iter first, Iter last)
+        {
+            this->reserve(static_cast<size_type>(mystl::distance(first, last)));
+            this->end_ = mystl::uninitialized_copy(first, last, this->begin());
+        }
+        // 释放元素与空间，之后 vector 不持有任何空间
+        void release_all() noexcept
+        {
+            this->destroy_and_recover(this->begin_, this->end_, this->capacity());
+            this->begin_ = this->end_ = this->capacity_ = nullptr;
+        }
+        Alloc &base_alloc() noexcept { return this->data_alloc().base(); }
+        // rhs 的堆缓冲区能否连同 Alloc 一起接管
+        bool can_steal(small_vector &rhs) noexcept
+        {
+            return !rhs.is_inline() &&
+                   (mystl::allocator_traits<Alloc>::propagate_on_container_move_assignment::value ||
+                    base_alloc() == rhs.base_alloc());
+        }
+        // 当前为空时接管 rhs 的元素，rhs 的元素在堆上时交出缓冲区并回到内部缓冲区
+        void take(small_vector &rhs);
+    };
+
+    template <class T, size_t N, class Alloc>
+    void small_vector<T, N, Alloc>::take(small_vector &rhs)
+    {
+        typedef mystl::allocator_traits<Alloc> traits;
+        MYSTL_DEBUG(this->empty() && this->capacity() >= N);
+        const bool steal = can_steal(rhs);
+        if (traits::propagate_on_container_move_assignment::value)
+        {
+            // 自己的空间要用原来的 Alloc 释放，之后换成 rhs 的 Alloc
+            release_all();
+            traits::move_assign(base_alloc(), rhs.base_alloc());
+            reset_inline();
+        }
+        if (steal)
+        {
+            release_all();
+            this->begin_ = rhs.begin_;
+            this->end_ = rhs.end_;
+            this->capacity_ = rhs.capacity_;
+            rhs.begin_ = rhs.end_ = rhs.capacity_ = nullptr;
+            rhs.reset_inline();
+            return;
+        }
+        // rhs 在内部缓冲区，或者 Alloc 不相等：用自己的空间逐个移动
+        this->reserve(rhs.size());
+        this->end_ = mystl::uninitialized_move(rhs.begin(), rhs.end(), this->begin());
+        rhs.clear();
+    }
+
+    // 堆上的元素在 Alloc 可以传播或相等时直接接管；其余情况逐个移动，自己的空间足够时保留
+    template <class T, size_t N, class Alloc>
+    small_vector<T, N, Alloc> &
+    small_vector<T, N, Alloc>::operator=(small_vector &&rhs) noexcept(
+        std::is_nothrow_move_constructible<T>::value &&
+        (mystl::allocator_traits<Alloc>::propagate_on_container_move_assignment::value ||
+         mystl::allocator_traits<Alloc>::is_always_equal::value))
+    {
+        if (this == &rhs)
+            return *this;
+        this->clear();
+        take(rhs);
+        return *this;
+    }
+
+    template <class T, size_t N, class Alloc>
+    void small_vector<T, N, Alloc>::shrink_to_fit()
+    {
+        if (is_inline())
+            return;
+        if (this->size() > N)
+        {
+            base::shrink_to_fit();
+            return;
+        }
+        // 堆上的元素不超过 N 个，搬回内部缓冲区
+        T *old_begin = this->begin_;
+        T *old_end = this->end_;
+        const size_type old_cap = this->capacity();
+        T *new_end = mystl::uninitialized_move(old_begin, old_end, storage_base::inline_data());
+        this->destroy_and_recover(old_begin, old_end, old_cap);
+        storage_base::inline_in_use_ = true;
+        this->begin_ = storage_base::inline_data();
+        this->end_ = new_end;
+        this->capacity_ = this->begin_ + N;
+    }
+
+    // 两边都在堆上且 Alloc 可以交换或相等时交换指针与 Alloc，否则借助一个临时对象移动三次
+    template <class T, size_t N, class Alloc>
+    void small_vector<T, N, Alloc>::swap(small_vector &rhs)
+    {
+        typedef mystl::allocator_traits<Alloc> traits;
+        if (this == &rhs)
+            return;
+        if (!is_inline() && !rhs.is_inline() &&
+            (traits::propagate_on_container_swap::value || base_alloc() == rhs.base_alloc()))
+        {
+            traits::swap(base_alloc(), rhs.base_alloc());
+            mystl::swap(this->begin_, rhs.begin_);
+            mystl::swap(this->end_, rhs.end_);
+            mystl::swap(this->capacity_, rhs.capacity_);
+            return;
+        }
+        small_vector tmp(mystl::move(*this));
+        *this = mystl::move(rhs);
+        rhs = mystl::move(tmp);
+    }
+
+    template <class T, size_t N, class Alloc>
+    void swap(small_vector<T, N, Alloc> &lhs, small_vector<T, N, Alloc> &rhs)
+    {
+        lhs.swap(rhs);
+    }
+}
+
+#endif
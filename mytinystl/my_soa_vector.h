@@ -0,0 +1,501 @@
+#ifndef MYTINYSTL_SOA_VECTOR_H_
+#define MYTINYSTL_SOA_VECTOR_H_
+
+// 这个头文件包含模板类 soa_vector<Ts...>，按列存放记录（structure of arrays）
+// 每个字段 Ts 各自一块连续的数组，所有列共用一个 size / capacity；只读一两个字段的扫描
+// 只会把这几列读进缓存，不像 vector<Record> 那样把整条记录都读进来
+//   column<I>()      : 第 I 列的 column_span，可以像数组一样遍历、下标访问
+//   operator[] / 迭代器 : 把同一行各列的元素打包成 std::tuple<Ts&...>，可以用结构化绑定
+//                      for (auto [id, price] : v) ...；这个元组是代理，交换两个元组不会交换两行
+//   push_back(tuple) / emplace_back(args...) : 每列一个实参
+// 扩容时新容量由 growth_1_5x 决定，每列用 uninitialized_relocate 搬到新区块，
+// 与 vector 相同，可以按字节搬移的列直接 memcpy
+// 各列使用 mystl::allocator<Ts> 分配
+//   例：mystl::soa_vector<int, double> v;  v.push_back(std::make_tuple(1, 2.0));
+//       double sum = 0;  for (double p : v.column<1>()) sum += p;
+
+#include <initializer_list>
+#include <tuple>
+#include <utility>
+
+#include "base/allocator.h"
+#include "base/growth_policy.h"
+#include "base/iterator.h"
+#include "base/uninitialized.h"
+#include "base/exceptdef.h"
+
+namespace mystl
+{
+    // 一列元素的视图，不拥有元素
+    template <class T>
+    class column_span
+    {
+    public:
+        typedef typename std::remove_const<T>::type value_type;
+        typedef T *pointer;
+        typedef T &reference;
+        typedef T *iterator;
+        typedef size_t size_type;
+
+    private:
+        T *data_;
+        size_type size_;
+
+    public:
+        column_span() noexcept : data_(nullptr), size_(0) {}
+        column_span(T *data, size_type size) noexcept : data_(data), size_(size) {}
+
+        T *data() const noexcept { return data_; }
+        size_type size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+        iterator begin() const noexcept { return data_; }
+        iterator end() const noexcept { return data_ + size_; }
+        reference operator[](size_type n) const
+        {
+            MYSTL_DEBUG(n < size_);
+            return data_[n];
+        }
+        reference front() const { return data_[0]; }
+        reference back() const { return data_[size_ - 1]; }
+    };
+
+    // 迭代器保存每列的起点与行号，解引用得到这一行各列的引用组成的元组
+    template <bool IsConst, class... Ts>
+    struct soa_iterator
+    {
+        typedef random_access_iterator_tag iterator_category;
+        typedef std::tuple<Ts...> value_type;
+        typedef ptrdiff_t difference_type;
+        typedef void pointer;
+        typedef typename std::conditional<IsConst, std::tuple<const Ts &...>, std::tuple<Ts &...>>::type reference;
+        typedef typename std::conditional<IsConst, std::tuple<const Ts *...>, std::tuple<Ts *...>>::type columns_type;
+        typedef soa_iterator self;
+
+        columns_type columns;
+        size_t pos;
+
+        soa_iterator() noexcept : columns(), pos(0) {}
+        soa_iterator(const columns_type &c, size_t p) noexcept : columns(c), pos(p) {}
+        // iterator 可以转换为 const_iterator
+        soa_iterator(const soa_iterator<false, Ts...> &rhs) noexcept : columns(rhs.columns), pos(rhs.pos) {}
+
+        reference operator*() const noexcept { return deref(std::index_sequence_for<Ts...>{}); }
+        reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+        self &operator++() noexcept
+        {
+            ++pos;
+            return *this;
+        }
+        self operator++(int) noexcept
+        {
+            self tmp = *this;
+            ++pos;
+            return tmp;
+        }
+        self &operator--() noexcept
+        {
+            --pos;
+            return *this;
+        }
+        self operator--(int) noexcept
+        {
+            self tmp = *this;
+            --pos;
+            return tmp;
+        }
+        self &operator+=(difference_type n) noexcept
+        {
+            pos += n;
+            return *this;
+        }
+        self &operator-=(difference_type n) noexcept
+        {
+            pos -= n;
+            return *this;
+        }
+        self operator+(difference_type n) const noexcept { return self(columns, pos + n); }
+        self operator-(difference_type n) const noexcept { return self(columns, pos - n); }
+        difference_type operator-(const self &rhs) const noexcept
+        {
+            return static_cast<difference_type>(pos) - static_cast<difference_type>(rhs.pos);
+        }
+
+        bool operator==(const self &rhs) const noexcept { return pos == rhs.pos; }
+        bool operator!=(const self &rhs) const noexcept { return pos != rhs.pos; }
+        bool operator<(const self &rhs) const noexcept { return pos < rhs.pos; }
+        bool operator>(const self &rhs) const noexcept { return pos > rhs.pos; }
+        bool operator<=(const self &rhs) const noexcept { return pos <= rhs.pos; }
+        bool operator>=(const self &rhs) const noexcept { return pos >= rhs.pos; }
+
+    private:
+        template <size_t... I>
+        reference deref(std::index_sequence<I...>) const noexcept
+        {
+            return reference(std::get<I>(columns)[pos]...);
+        }
+    };
+
+    // --------------------------------------------------------------------------------------
+    // 模板类：soa_vector
+    template <class... Ts>
+    class soa_vector
+    {
+        static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+
+    public:
+        typedef std::tuple<Ts...> value_type;
+        typedef std::tuple<Ts &...> reference;
+        typedef std::tuple<const Ts &...> const_reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+        typedef soa_iterator<false, Ts...> iterator;
+        typedef soa_iterator<true, Ts...> const_iterator;
+
+        template <size_t I>
+        using column_type = typename std::tuple_element<I, value_type>::type;
+
+        static constexpr size_type columns = sizeof...(Ts);
+
+    private:
+        typedef std::tuple<Ts *...> pointers;
+        typedef std::index_sequence_for<Ts...> indices;
+
+        pointers data_;     // 每列的起点
+        size_type size_;
+        size_type capacity_;
+
+    public:
+        /*********************构造、复制、移动、析构**************/
+        soa_vector() noexcept : data_(), size_(0), capacity_(0) {}
+        explicit soa_vector(size_type n) : soa_vector() { resize(n); }
+        soa_vector(std::initializer_list<value_type> ilist) : soa_vector()
+        {
+            reserve(ilist.size());
+            for (auto &row : ilist)
+                push_back(row);
+        }
+        soa_vector(const soa_vector &rhs);
+        soa_vector(soa_vector &&rhs) noexcept
+            : data_(rhs.data_), size_(rhs.size_), capacity_(rhs.capacity_)
+        {
+            rhs.data_ = pointers();
+            rhs.size_ = 0;
+            rhs.capacity_ = 0;
+        }
+        soa_vector &operator=(const soa_vector &rhs)
+        {
+            if (this != &rhs)
+            {
+                soa_vector tmp(rhs);
+                swap(tmp);
+            }
+            return *this;
+        }
+        soa_vector &operator=(soa_vector &&rhs) noexcept
+        {
+            soa_vector tmp(mystl::move(rhs));
+            swap(tmp);
+            return *this;
+        }
+        ~soa_vector()
+        {
+            destroy_rows(0, size_, indices{});
+            deallocate_columns(data_, capacity_, indices{});
+        }
+
+        /*********************迭代器相关操作**************/
+        iterator begin() noexcept { return iterator(data_, 0); }
+        const_iterator begin() const noexcept { return const_iterator(const_columns(indices{}), 0); }
+        iterator end() noexcept { return iterator(data_, size_); }
+        const_iterator end() const noexcept { return const_iterator(const_columns(indices{}), size_); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+
+        /*********************容量相关操作**************/
+        bool empty() const noexcept { return size_ == 0; }
+        size_type size() const noexcept { return size_; }
+        size_type capacity() const noexcept { return capacity_; }
+        size_type max_size() const noexcept { return static_cast<size_type>(-1) / row_bytes(); }
+        void reserve(size_type n)
+        {
+            if (capacity_ < n)
+            {
+                THROW_LENGTH_ERROR_IF(n > max_size(), "n can not larger than max_size() in soa_vector::reserve(n)");
+                reallocate(n);
+            }
+        }
+        void shrink_to_fit()
+        {
+            if (size_ < capacity_)
+                reallocate(size_);
+        }
+
+        /*********************访问元素相关操作**************/
+        template <size_t I>
+        column_span<column_type<I>> column() noexcept
+        {
+            return column_span<column_type<I>>(std::get<I>(data_), size_);
+        }
+        template <size_t I>
+        column_span<const column_type<I>> column() const noexcept
+        {
+            return column_span<const column_type<I>>(std::get<I>(data_), size_);
+        }
+        template <size_t I>
+        column_type<I> *data() noexcept { return std::get<I>(data_); }
+        template <size_t I>
+        const column_type<I> *data() const noexcept { return std::get<I>(data_); }
+
+        reference operator[](size_type n)
+        {
+            MYSTL_DEBUG(n < size_);
+            return *(begin() + n);
+        }
+        const_reference operator[](size_type n) const
+        {
+            MYSTL_DEBUG(n < size_);
+            return *(begin() + n);
+        }
+        reference at(size_type n)
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size_), "soa_vector::at() subscript out of range");
+            return (*this)[n];
+        }
+        const_reference at(size_type n) const
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size_), "soa_vector::at() subscript out of range");
+            return (*this)[n];
+        }
+        reference front() { return (*this)[0]; }
+        const_reference front() const { return (*this)[0]; }
+        reference back() { return (*this)[size_ - 1]; }
+        const_reference back() const { return (*this)[size_ - 1]; }
+
+        /*********************修改容器相关操作**************/
+        // 每列一个实参
+        template <class... Args>
+        void emplace_back(Args &&...args)
+        {
+            static_assert(sizeof...(Args) == sizeof...(Ts), "soa_vector::emplace_back needs one argument per column");
+            append_row(std::forward_as_tuple(mystl::forward<Args>(args)...));
+        }
+        void push_back(const value_type &row) { append_row(row); }
+        void push_back(value_type &&row) { append_row(mystl::move(row)); }
+        void pop_back()
+        {
+            MYSTL_DEBUG(!empty());
+            destroy_rows(size_ - 1, size_, indices{});
+            --size_;
+        }
+        // 新增的行各列值初始化
+        void resize(size_type n);
+        void clear() noexcept
+        {
+            destroy_rows(0, size_, indices{});
+            size_ = 0;
+        }
+        void swap(soa_vector &rhs) noexcept
+        {
+            mystl::swap(data_, rhs.data_);
+            mystl::swap(size_, rhs.size_);
+            mystl::swap(capacity_, rhs.capacity_);
+        }
+
+    private:
+        static constexpr size_type row_bytes() noexcept
+        {
+            size_type bytes = 0;
+            for (size_type s : {sizeof(Ts)...})
+                bytes += s;
+            return bytes;
+        }
+        size_type get_new_cap() const
+        {
+            THROW_LENGTH_ERROR_IF(size_ == max_size(), "soa_vector's size too big");
+            const size_type new_cap = mystl::growth_1_5x().next_capacity(capacity_, size_ + 1, max_size());
+            return new_cap < size_ + 1 ? size_ + 1 : (new_cap > max_size() ? max_size() : new_cap);
+        }
+
+        template <size_t... I>
+        std::tuple<const Ts *...> const_columns(std::index_sequence<I...>) const noexcept
+        {
+            return std::tuple<const Ts *...>(std::get<I>(data_)...);
+        }
+
+        // 为每列分配 n 个元素，某一列失败时释放已经分配的列
+        template <size_t... I>
+        static pointers allocate_columns(size_type n, std::index_sequence<I...>);
+        template <size_t... I>
+        static void deallocate_columns(const pointers &p, size_type n, std::index_sequence<I...>) noexcept
+        {
+            (mystl::allocator<Ts>::deallocate(std::get<I>(p), n), ...);
+        }
+        template <size_t... I>
+        void destroy_rows(size_type first, size_type last, std::index_sequence<I...>) noexcept
+        {
+            (mystl::destroy(std::get<I>(data_) + first, std::get<I>(data_) + last), ...);
+        }
+        // 在 columns 各列的第 size_ 行逐列构造，第 k 列抛出异常时析构前 k 列
+        template <class Tuple, size_t... I>
+        void construct_row(const pointers &columns, Tuple &&row, std::index_sequence<I...>);
+        template <class Tuple>
+        void append_row(Tuple &&row);
+        template <size_t... I>
+        void copy_columns(const soa_vector &rhs, std::index_sequence<I...>);
+        template <size_t... I>
+        void relocate_columns(const pointers &to, std::index_sequence<I...>);
+
+        void reallocate(size_type new_cap);
+    };
+
+    /*****************************************************************************************/
+    template <class... Ts>
+    soa_vector<Ts...>::soa_vector(const soa_vector &rhs)
+        : data_(allocate_columns(rhs.size_, indices{})), size_(0), capacity_(rhs.size_)
+    {
+        try
+        {
+            copy_columns(rhs, indices{});
+        }
+        catch (...)
+        {
+            deallocate_columns(data_, capacity_, indices{});
+            throw;
+        }
+        size_ = rhs.size_;
+    }
+
+    template <class... Ts>
+    void soa_vector<Ts...>::resize(size_type n)
+    {
+        if (n < size_)
+        {
+            destroy_rows(n, size_, indices{});
+            size_ = n;
+            return;
+        }
+        reserve(n);
+        while (size_ < n)
+            emplace_back(Ts()...);
+    }
+
+    template <class... Ts>
+    template <size_t... I>
+    typename soa_vector<Ts...>::pointers
+    soa_vector<Ts...>::allocate_columns(size_type n, std::index_sequence<I...>)
+    {
+        pointers p;
+        if (n == 0)
+            return p;
+        try
+        {
+            ((std::get<I>(p) = mystl::allocator<Ts>::allocate(n)), ...);
+        }
+        catch (...)
+        {
+            deallocate_columns(p, n, indices{});
+            throw;
+        }
+        return p;
+    }
+
+    template <class... Ts>
+    template <class Tuple, size_t... I>
+    void soa_vector<Ts...>::construct_row(const pointers &columns, Tuple &&row, std::index_sequence<I...>)
+    {
+        size_type built = 0;
+        try
+        {
+            ((mystl::construct(std::get<I>(columns) + size_, std::get<I>(mystl::forward<Tuple>(row))), ++built),
+             ...);
+        }
+        catch (...)
+        {
+            ((I < built ? mystl::destroy(std::get<I>(columns) + size_) : void()), ...);
+            throw;
+        }
+    }
+
+    // 在末尾添加一行。容量已满时与 vector 的 reallocate_emplace 相同：先在新区块中构造新行，
+    // 再搬移旧元素、释放旧区块，实参引用容器内的元素时仍然有效
+    template <class... Ts>
+    template <class Tuple>
+    void soa_vector<Ts...>::append_row(Tuple &&row)
+    {
+        if (size_ != capacity_)
+        {
+            construct_row(data_, mystl::forward<Tuple>(row), indices{});
+            ++size_;
+            return;
+        }
+        const size_type new_cap = get_new_cap();
+        pointers p = allocate_columns(new_cap, indices{});
+        try
+        {
+            construct_row(p, mystl::forward<Tuple>(row), indices{});
+        }
+        catch (...)
+        {
+            deallocate_columns(p, new_cap, indices{});
+            throw;
+        }
+        relocate_columns(p, indices{});
+        deallocate_columns(data_, capacity_, indices{});
+        data_ = p;
+        capacity_ = new_cap;
+        ++size_;
+    }
+
+    // 逐列复制，第 k 列抛出异常时析构前 k 列
+    template <class... Ts>
+    template <size_t... I>
+    void soa_vector<Ts...>::copy_columns(const soa_vector &rhs, std::index_sequence<I...>)
+    {
+        size_type built = 0;
+        try
+        {
+            ((mystl::uninitialized_copy(std::get<I>(rhs.data_), std::get<I>(rhs.data_) + rhs.size_,
+                                        std::get<I>(data_)),
+              ++built),
+             ...);
+        }
+        catch (...)
+        {
+            ((I < built ? mystl::destroy(std::get<I>(data_), std::get<I>(data_) + rhs.size_) : void()), ...);
+            throw;
+        }
+    }
+
+    // 与 vector 扩容时相同，可以按字节搬移的列 memcpy，其他列逐个移动构造再析构
+    template <class... Ts>
+    template <size_t... I>
+    void soa_vector<Ts...>::relocate_columns(const pointers &to, std::index_sequence<I...>)
+    {
+        (mystl::uninitialized_relocate(std::get<I>(data_), std::get<I>(data_) + size_, std::get<I>(to)), ...);
+    }
+
+    // 先为所有列分配好新区块再搬移，分配失败时原来的元素不变
+    template <class... Ts>
+    void soa_vector<Ts...>::reallocate(size_type new_cap)
+    {
+        pointers p = allocate_columns(new_cap, indices{});
+        relocate_columns(p, indices{});
+        deallocate_columns(data_, capacity_, indices{});
+        data_ = p;
+        capacity_ = new_cap;
+    }
+
+    template <class... Ts>
+    void swap(soa_vector<Ts...> &lhs, soa_vector<Ts...> &rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    // 只保存每列的指针
+    template <class... Ts>
+    struct is_trivially_relocatable<soa_vector<Ts...>> : std::true_type
+    {
+    };
+} // namespace mystl
+#endif // !MYTINYSTL_SOA_VECTOR_H_
@@ -0,0 +1,471 @@
+#ifndef MYTINYSTL_STABLE_VECTOR_H_
+#define MYTINYSTL_STABLE_VECTOR_H_
+
+// 这个头文件包含模板类 stable_vector，分段存放元素，扩容时从不搬移已有的元素
+// 第 k 段可以放 FirstSegment << k 个元素，容量用完时只分配下一段，原来的元素、指针和引用都不变，
+// 因此 push_back 最坏情况也只是一次分配，不会像 vector 的 reallocate_insert 那样复制整个缓冲区
+// 下标 i 所在的段由 i + FirstSegment 的最高位直接算出（一次 clz），段表是对象内部的定长数组，
+// 下标访问是 O(1) 的，段表本身也从不重新分配
+// 各段不连续，没有 data()；只支持在末尾增删
+// 移动、交换 stable_vector 后迭代器失效（迭代器指向对象内的段表），元素的指针与引用仍然有效
+//   例：mystl::stable_vector<Order> orders;  Order &o = orders.emplace_back(...);  // o 一直有效
+
+#include <initializer_list>
+
+#include "base/allocator.h"
+#include "base/allocator_traits.h"
+#include "base/iterator.h"
+#include "base/memory_resource.h"
+#include "base/uninitialized.h"
+#include "base/exceptdef.h"
+
+namespace mystl
+{
+    constexpr size_t segment_shift(size_t first) noexcept
+    {
+        return first <= 1 ? 0 : 1 + segment_shift(first / 2);
+    }
+
+    // 下标到段号与段内偏移的换算，Shift = log2(FirstSegment)
+    template <size_t Shift>
+    struct segment_index
+    {
+        static constexpr size_t first = size_t(1) << Shift;
+        static constexpr size_t max_segments = 64 - Shift;
+
+        static size_t high_bit(size_t x) noexcept
+        {
+#if defined(__GNUC__)
+            return 63 - static_cast<size_t>(__builtin_clzll(x));
+#else
+            size_t h = 0;
+            while (x >>= 1)
+                ++h;
+            return h;
+#endif
+        }
+        static size_t segment(size_t i) noexcept { return high_bit(i + first) - Shift; }
+        static size_t offset(size_t i, size_t seg) noexcept { return i + first - (first << seg); }
+        static size_t segment_size(size_t seg) noexcept { return first << seg; }
+        // 前 n 段的总容量
+        static size_t capacity(size_t n) noexcept { return n == 0 ? 0 : (first << n) - first; }
+    };
+
+    // 迭代器缓存当前段的范围，逐个移动时只在跨段时查段表
+    template <class T, class Ref, class Ptr, size_t Shift>
+    struct stable_vector_iterator
+    {
+        typedef random_access_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef Ptr pointer;
+        typedef Ref reference;
+        typedef ptrdiff_t difference_type;
+        typedef stable_vector_iterator<T, T &, T *, Shift> iterator;
+        typedef stable_vector_iterator self;
+        typedef mystl::segment_index<Shift> index;
+
+        T *const *segments;
+        size_t pos;
+        size_t seg;
+        T *cur;
+        T *seg_end;
+
+        stable_vector_iterator() noexcept : segments(nullptr), pos(0), seg(0), cur(nullptr), seg_end(nullptr) {}
+        stable_vector_iterator(T *const *s, size_t p) noexcept : segments(s), pos(p) { locate(); }
+        stable_vector_iterator(const iterator &rhs) noexcept
+            : segments(rhs.segments), pos(rhs.pos), seg(rhs.seg), cur(rhs.cur), seg_end(rhs.seg_end)
+        {
+        }
+
+        reference operator*() const noexcept { return *cur; }
+        pointer operator->() const noexcept { return cur; }
+        reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+        self &operator++() noexcept
+        {
+            ++pos;
+            if (++cur == seg_end)
+                enter(seg + 1);
+            return *this;
+        }
+        self operator++(int) noexcept
+        {
+            self tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        self &operator--() noexcept
+        {
+            --pos;
+            if (cur == segments[seg])
+            {
+                enter(seg - 1);
+                cur = seg_end;
+            }
+            --cur;
+            return *this;
+        }
+        self operator--(int) noexcept
+        {
+            self tmp = *this;
+            --*this;
+            return tmp;
+        }
+        self &operator+=(difference_type n) noexcept
+        {
+            pos += n;
+            locate();
+            return *this;
+        }
+        self &operator-=(difference_type n) noexcept { return *this += -n; }
+        self operator+(difference_type n) const noexcept { return self(segments, pos + n); }
+        self operator-(difference_type n) const noexcept { return self(segments, pos - n); }
+        difference_type operator-(const self &rhs) const noexcept
+        {
+            return static_cast<difference_type>(pos) - static_cast<difference_type>(rhs.pos);
+        }
+
+        bool operator==(const self &rhs) const noexcept { return pos == rhs.pos; }
+        bool operator!=(const self &rhs) const noexcept { return pos != rhs.pos; }
+        bool operator<(const self &rhs) const noexcept { return pos < rhs.pos; }
+        bool operator>(const self &rhs) const noexcept { return pos > rhs.pos; }
+        bool operator<=(const self &rhs) const noexcept { return pos <= rhs.pos; }
+        bool operator>=(const self &rhs) const noexcept { return pos >= rhs.pos; }
+
+    private:
+        // 段还没有分配时（end() 恰好在段的边界上）cur 与 seg_end 为空
+        void enter(size_t s) noexcept
+        {
+            seg = s;
+            cur = s < index::max_segments ? segments[s] : nullptr;
+            seg_end = cur == nullptr ? nullptr : cur + index::segment_size(s);
+        }
+        void locate() noexcept
+        {
+            const size_t s = index::segment(pos);
+            enter(s);
+            if (cur != nullptr)
+                cur += index::offset(pos, s);
+        }
+    };
+
+    // --------------------------------------------------------------------------------------
+    // 模板类：stable_vector
+    // FirstSegment 为第一段的元素个数，必须是 2 的幂
+    template <class T, class Alloc = mystl::allocator<T>, size_t FirstSegment = 16>
+    class stable_vector : private allocator_holder<Alloc>
+    {
+        static_assert(FirstSegment > 0 && (FirstSegment & (FirstSegment - 1)) == 0,
+                      "FirstSegment must be a power of 2");
+        static constexpr size_t shift = mystl::segment_shift(FirstSegment);
+
+    public:
+        typedef Alloc allocator_type;
+        typedef mystl::allocator_traits<Alloc> alloc_traits;
+
+        typedef typename alloc_traits::value_type value_type;
+        typedef typename alloc_traits::pointer pointer;
+        typedef typename alloc_traits::const_pointer const_pointer;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef typename alloc_traits::size_type size_type;
+        typedef typename alloc_traits::difference_type difference_type;
+
+        static_assert(std::is_same<T, value_type>::value, "Alloc::value_type must be same as T");
+
+        typedef stable_vector_iterator<T, T &, T *, shift> iterator;
+        typedef stable_vector_iterator<T, const T &, const T *, shift> const_iterator;
+        typedef mystl::reverse_iterator<iterator> reverse_iterator;
+        typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    private:
+        typedef mystl::allocator_holder<Alloc> alloc_base;
+        typedef mystl::segment_index<shift> index;
+
+        T *segments_[index::max_segments]; // 段表，前 allocated_ 项有效
+        size_type allocated_;              // 已经分配的段数
+        size_type size_;
+
+    public:
+        /*********************构造、复制、移动、析构**************/
+        stable_vector() noexcept(noexcept(Alloc())) : alloc_base(), segments_(), allocated_(0), size_(0) {}
+        explicit stable_vector(const allocator_type &alloc) noexcept
+            : alloc_base(alloc), segments_(), allocated_(0), size_(0)
+        {
+        }
+        explicit stable_vector(size_type n, const value_type &value = value_type(),
+                               const allocator_type &alloc = allocator_type())
+            : stable_vector(alloc)
+        {
+            resize(n, value);
+        }
+        stable_vector(std::initializer_list<value_type> ilist, const allocator_type &alloc = allocator_type())
+            : stable_vector(alloc)
+        {
+            reserve(ilist.size());
+            for (auto &value : ilist)
+                push_back(value);
+        }
+        stable_vector(const stable_vector &rhs)
+            : stable_vector(alloc_traits::select_on_container_copy_construction(rhs.data_alloc()))
+        {
+            reserve(rhs.size_);
+            for (auto &value : rhs)
+                push_back(value);
+        }
+        stable_vector(stable_vector &&rhs) noexcept
+            : alloc_base(mystl::move(rhs.data_alloc())), allocated_(rhs.allocated_), size_(rhs.size_)
+        {
+            for (size_type i = 0; i < index::max_segments; ++i)
+                segments_[i] = rhs.segments_[i];
+            rhs.forget();
+        }
+        stable_vector &operator=(const stable_vector &rhs);
+        stable_vector &operator=(stable_vector &&rhs);
+        ~stable_vector()
+        {
+            clear();
+            release_segments(0);
+        }
+
+        allocator_type get_allocator() const { return data_alloc(); }
+
+        /*********************迭代器相关操作**************/
+        iterator begin() noexcept { return iterator(segments_, 0); }
+        const_iterator begin() const noexcept { return const_iterator(segments_, 0); }
+        iterator end() noexcept { return iterator(segments_, size_); }
+        const_iterator end() const noexcept { return const_iterator(segments_, size_); }
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+
+        /*********************容量相关操作**************/
+        bool empty() const noexcept { return size_ == 0; }
+        size_type size() const noexcept { return size_; }
+        size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(T); }
+        size_type capacity() const noexcept { return index::capacity(allocated_); }
+        size_type segment_count() const noexcept { return allocated_; }
+        // 预先分配到至少 n 个元素，之后的 push_back 不再分配
+        void reserve(size_type n);
+        // 释放没有元素的段
+        void shrink_to_fit() noexcept
+        {
+            release_segments(size_ == 0 ? 0 : index::segment(size_ - 1) + 1);
+        }
+
+        /*********************访问元素相关操作**************/
+        reference operator[](size_type n)
+        {
+            MYSTL_DEBUG(n < size_);
+            return *element(n);
+        }
+        const_reference operator[](size_type n) const
+        {
+            MYSTL_DEBUG(n < size_);
+            return *element(n);
+        }
+        reference at(size_type n)
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size_), "stable_vector<T>::at() subscript out of range");
+            return (*this)[n];
+        }
+        const_reference at(size_type n) const
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size_), "stable_vector<T>::at() subscript out of range");
+            return (*this)[n];
+        }
+        reference front() { return (*this)[0]; }
+        const_reference front() const { return (*this)[0]; }
+        reference back() { return (*this)[size_ - 1]; }
+        const_reference back() const { return (*this)[size_ - 1]; }
+
+        /*********************修改容器相关操作**************/
+        template <class... Args>
+        reference emplace_back(Args &&...args);
+        void push_back(const value_type &value) { emplace_back(value); }
+        void push_back(value_type &&value) { emplace_back(mystl::move(value)); }
+        void pop_back()
+        {
+            MYSTL_DEBUG(!empty());
+            alloc_traits::destroy(data_alloc(), element(size_ - 1));
+            --size_;
+        }
+        void resize(size_type n) { resize(n, value_type()); }
+        void resize(size_type n, const value_type &value);
+        // 析构所有元素，保留已经分配的段
+        void clear() noexcept
+        {
+            while (size_ != 0)
+                pop_back();
+        }
+        void swap(stable_vector &rhs) noexcept;
+
+    private:
+        Alloc &data_alloc() noexcept { return alloc_base::get(); }
+        const Alloc &data_alloc() const noexcept { return alloc_base::get(); }
+
+        T *element(size_type n) const noexcept
+        {
+            const size_type s = index::segment(n);
+            return segments_[s] + index::offset(n, s);
+        }
+        void add_segment();
+        // 释放第 keep 段之后的所有段，这些段中不能有元素
+        void release_segments(size_type keep) noexcept;
+        void forget() noexcept
+        {
+            for (size_type i = 0; i < index::max_segments; ++i)
+                segments_[i] = nullptr;
+            allocated_ = 0;
+            size_ = 0;
+        }
+    };
+
+    /*****************************************************************************************/
+    template <class T, class Alloc, size_t FirstSegment>
+    stable_vector<T, Alloc, FirstSegment> &
+    stable_vector<T, Alloc, FirstSegment>::operator=(const stable_vector &rhs)
+    {
+        if (this != &rhs)
+        {
+            clear();
+            if (alloc_traits::propagate_on_container_copy_assignment::value && data_alloc() != rhs.data_alloc())
+                release_segments(0);
+            alloc_traits::copy_assign(data_alloc(), rhs.data_alloc());
+            reserve(rhs.size_);
+            for (auto &value : rhs)
+                push_back(value);
+        }
+        return *this;
+    }
+
+    // 配置器可以传播或相等时接管对方的段，否则逐个移动元素
+    template <class T, class Alloc, size_t FirstSegment>
+    stable_vector<T, Alloc, FirstSegment> &
+    stable_vector<T, Alloc, FirstSegment>::operator=(stable_vector &&rhs)
+    {
+        if (this == &rhs)
+            return *this;
+        clear();
+        if (alloc_traits::propagate_on_container_move_assignment::value || data_alloc() == rhs.data_alloc())
+        {
+            release_segments(0);
+            alloc_traits::move_assign(data_alloc(), rhs.data_alloc());
+            for (size_type i = 0; i < index::max_segments; ++i)
+                segments_[i] = rhs.segments_[i];
+            allocated_ = rhs.allocated_;
+            size_ = rhs.size_;
+            rhs.forget();
+        }
+        else
+        {
+            reserve(rhs.size_);
+            for (auto &value : rhs)
+                push_back(mystl::move(value));
+            rhs.clear();
+        }
+        return *this;
+    }
+
+    template <class T, class Alloc, size_t FirstSegment>
+    void stable_vector<T, Alloc, FirstSegment>::reserve(size_type n)
+    {
+        THROW_LENGTH_ERROR_IF(n > max_size(), "n can not larger than max_size() in stable_vector<T>::reserve(n)");
+        while (capacity() < n)
+            add_segment();
+    }
+
+    // 容量用完时只分配下一段，已有的元素不动
+    template <class T, class Alloc, size_t FirstSegment>
+    template <class... Args>
+    typename stable_vector<T, Alloc, FirstSegment>::reference
+    stable_vector<T, Alloc, FirstSegment>::emplace_back(Args &&...args)
+    {
+        if (size_ == capacity())
+            add_segment();
+        T *p = element(size_);
+        alloc_traits::construct(data_alloc(), p, mystl::forward<Args>(args)...);
+        ++size_;
+        return *p;
+    }
+
+    template <class T, class Alloc, size_t FirstSegment>
+    void stable_vector<T, Alloc, FirstSegment>::resize(size_type n, const value_type &value)
+    {
+        if (n < size_)
+        {
+            while (size_ > n)
+                pop_back();
+            return;
+        }
+        reserve(n);
+        while (size_ < n)
+            emplace_back(value);
+    }
+
+    template <class T, class Alloc, size_t FirstSegment>
+    void stable_vector<T, Alloc, FirstSegment>::swap(stable_vector &rhs) noexcept
+    {
+        MYSTL_DEBUG(alloc_traits::propagate_on_container_swap::value || data_alloc() == rhs.data_alloc());
+        if (this != &rhs)
+        {
+            alloc_traits::swap(data_alloc(), rhs.data_alloc());
+            for (size_type i = 0; i < index::max_segments; ++i)
+                mystl::swap(segments_[i], rhs.segments_[i]);
+            mystl::swap(allocated_, rhs.allocated_);
+            mystl::swap(size_, rhs.size_);
+        }
+    }
+
+    template <class T, class Alloc, size_t FirstSegment>
+    void stable_vector<T, Alloc, FirstSegment>::add_segment()
+    {
+        THROW_LENGTH_ERROR_IF(allocated_ == index::max_segments ||
+                                  index::segment_size(allocated_) > max_size() - capacity(),
+                              "stable_vector<T>'s size too big");
+        const size_type n = index::segment_size(allocated_);
+        segments_[allocated_] = mystl::to_address(alloc_traits::allocate(data_alloc(), n));
+        ++allocated_;
+    }
+
+    template <class T, class Alloc, size_t FirstSegment>
+    void stable_vector<T, Alloc, FirstSegment>::release_segments(size_type keep) noexcept
+    {
+        MYSTL_DEBUG(index::capacity(keep) >= size_);
+        while (allocated_ > keep)
+        {
+            --allocated_;
+            alloc_traits::deallocate(data_alloc(), segments_[allocated_], index::segment_size(allocated_));
+            segments_[allocated_] = nullptr;
+        }
+    }
+
+    // 重载比较操作符与 swap
+    template <class T, class Alloc, size_t FirstSegment>
+    bool operator==(const stable_vector<T, Alloc, FirstSegment> &lhs,
+                    const stable_vector<T, Alloc, FirstSegment> &rhs)
+    {
+        return lhs.size() == rhs.size() && mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+    template <class T, class Alloc, size_t FirstSegment>
+    bool operator!=(const stable_vector<T, Alloc, FirstSegment> &lhs,
+                    const stable_vector<T, Alloc, FirstSegment> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+    template <class T, class Alloc, size_t FirstSegment>
+    void swap(stable_vector<T, Alloc, FirstSegment> &lhs, stable_vector<T, Alloc, FirstSegment> &rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+    namespace pmr
+    {
+        template <class T>
+        using stable_vector = mystl::stable_vector<T, polymorphic_allocator<T>>;
+    }
+} // namespace mystl
+#endif // !MYTINYSTL_STABLE_VECTOR_H_
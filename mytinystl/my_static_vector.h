@@ -0,0 +1,470 @@
+#ifndef MYTINYSTL_STATIC_VECTOR_H_
+#define MYTINYSTL_STATIC_VECTOR_H_
+
+// 这个头文件包含模板类 static_vector，容量固定为 N、元素全部放在对象内部，从不访问堆
+// 接口与 vector 相同（没有配置器），插入、删除的做法与 vector 在备用空间足够时的分支一致
+// 超出容量时的处理由 Checked 决定：
+//   static_vector<T, N>            : 抛出 std::length_error，元素不变
+//   unchecked_static_vector<T, N>  : 只有 MYSTL_DEBUG 断言，发布版本中不做检查，调用者自己保证不溢出
+// 对象内部只有元素个数和缓冲区，没有指针，T 可以按字节复制时 static_vector 也可以按字节复制，
+// 作为元素时 copy、move 等算法会走 memmove 的分支
+//   例：mystl::static_vector<int, 16> v;  v.push_back(1);
+
+#include <initializer_list>
+
+#include "base/iterator.h"
+#include "base/memory.h"
+#include "base/destroy.h"
+#include "base/util.h"
+#include "base/exceptdef.h"
+
+namespace mystl
+{
+    // 元素个数与缓冲区，T 可以按字节复制时全部使用默认的复制、移动和析构
+    template <class T, size_t N, bool = std::is_trivially_copyable<T>::value>
+    class static_vector_storage
+    {
+    protected:
+        size_t size_ = 0;
+        alignas(T) unsigned char buffer_[N * sizeof(T)];
+
+        T *ptr() noexcept { return reinterpret_cast<T *>(buffer_); }
+        const T *ptr() const noexcept { return reinterpret_cast<const T *>(buffer_); }
+    };
+
+    // 其他类型逐个复制、移动和析构元素
+    template <class T, size_t N>
+    class static_vector_storage<T, N, false>
+    {
+    protected:
+        size_t size_ = 0;
+        alignas(T) unsigned char buffer_[N * sizeof(T)];
+
+        T *ptr() noexcept { return reinterpret_cast<T *>(buffer_); }
+        const T *ptr() const noexcept { return reinterpret_cast<const T *>(buffer_); }
+
+    public:
+        static_vector_storage() = default;
+        static_vector_storage(const static_vector_storage &rhs)
+        {
+            mystl::uninitialized_copy(rhs.ptr(), rhs.ptr() + rhs.size_, ptr());
+            size_ = rhs.size_;
+        }
+        static_vector_storage(static_vector_storage &&rhs) noexcept(std::is_nothrow_move_constructible<T>::value)
+        {
+            mystl::uninitialized_move(rhs.ptr(), rhs.ptr() + rhs.size_, ptr());
+            size_ = rhs.size_;
+        }
+        static_vector_storage &operator=(const static_vector_storage &rhs)
+        {
+            if (this != &rhs)
+                assign_from(rhs.ptr(), rhs.size_, std::false_type());
+            return *this;
+        }
+        static_vector_storage &operator=(static_vector_storage &&rhs) noexcept(
+            std::is_nothrow_move_assignable<T>::value && std::is_nothrow_move_constructible<T>::value)
+        {
+            if (this != &rhs)
+                assign_from(rhs.ptr(), rhs.size_, std::true_type());
+            return *this;
+        }
+        ~static_vector_storage()
+        {
+            mystl::destroy(ptr(), ptr() + size_);
+        }
+
+    private:
+        // 与 vector 的复制赋值相同：已有的元素赋值，多出的构造或析构
+        template <class Ptr, class Move>
+        void assign_from(Ptr src, size_t n, Move)
+        {
+            const size_t common = size_ < n ? size_ : n;
+            for (size_t i = 0; i < common; ++i)
+                ptr()[i] = forward_elem(src[i], Move());
+            if (size_ > n)
+            {
+                mystl::destroy(ptr() + n, ptr() + size_);
+                size_ = n;
+            }
+            for (; size_ < n; ++size_)
+                mystl::construct(ptr() + size_, forward_elem(src[size_], Move()));
+        }
+        static T &&forward_elem(T &x, std::true_type) noexcept { return mystl::move(x); }
+        static const T &forward_elem(const T &x, std::false_type) noexcept { return x; }
+    };
+
+    // --------------------------------------------------------------------------------------
+    // 模板类：static_vector
+    template <class T, size_t N, bool Checked = true>
+    class static_vector : private static_vector_storage<T, N>
+    {
+        static_assert(N > 0, "static_vector needs a capacity of at least one element");
+
+    private:
+        typedef static_vector_storage<T, N> storage_base;
+
+    public:
+        typedef T value_type;
+        typedef T *pointer;
+        typedef const T *const_pointer;
+        typedef T &reference;
+        typedef const T &const_reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+
+        typedef value_type *iterator;
+        typedef const value_type *const_iterator;
+        typedef mystl::reverse_iterator<iterator> reverse_iterator;
+        typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
+
+        static constexpr bool checked = Checked;
+
+    public:
+        static_vector() = default;
+        explicit static_vector(size_type n)
+        {
+            fill_insert(end(), n, value_type());
+        }
+        static_vector(size_type n, const value_type &value)
+        {
+            fill_insert(end(), n, value);
+        }
+        template <class Iter, typename std::enable_if<
+                                  mystl::is_input_iterator<Iter>::value, int>::type = 0>
+        static_vector(Iter first, Iter last)
+        {
+            MYSTL_DEBUG(!(last < first));
+            copy_insert(end(), first, last);
+        }
+        static_vector(std::initializer_list<value_type> ilist)
+        {
+            copy_insert(end(), ilist.begin(), ilist.end());
+        }
+        static_vector &operator=(std::initializer_list<value_type> ilist)
+        {
+            check_room(ilist.size() > size() ? ilist.size() - size() : 0);
+            clear();
+            copy_insert(end(), ilist.begin(), ilist.end());
+            return *this;
+        }
+
+        /*********************迭代器**********************/
+        iterator begin() noexcept { return this->ptr(); }
+        const_iterator begin() const noexcept { return this->ptr(); }
+        iterator end() noexcept { return this->ptr() + this->size_; }
+        const_iterator end() const noexcept { return this->ptr() + this->size_; }
+        reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+        const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+        const_reverse_iterator crend() const noexcept { return rend(); }
+
+        /*********************容量操作********************/
+        bool empty() const noexcept { return this->size_ == 0; }
+        bool full() const noexcept { return this->size_ == N; }
+        size_type size() const noexcept { return this->size_; }
+        static constexpr size_type max_size() noexcept { return N; }
+        static constexpr size_type capacity() noexcept { return N; }
+        // 容量是固定的，只检查 n 是否放得下
+        void reserve(size_type n)
+        {
+            check_room(n > size() ? n - size() : 0);
+        }
+        void shrink_to_fit() noexcept {}
+
+        /*********************访问元素操作****************/
+        reference operator[](size_type n)
+        {
+            MYSTL_DEBUG(n < size());
+            return begin()[n];
+        }
+        const_reference operator[](size_type n) const
+        {
+            MYSTL_DEBUG(n < size());
+            return begin()[n];
+        }
+        reference at(size_type n)
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "static_vector<T, N>::at() subscript out of range");
+            return (*this)[n];
+        }
+        const_reference at(size_type n) const
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "static_vector<T, N>::at() subscript out of range");
+            return (*this)[n];
+        }
+        reference front()
+        {
+            MYSTL_DEBUG(!empty());
+            return *begin();
+        }
+        const_reference front() const
+        {
+            MYSTL_DEBUG(!empty());
+            return *begin();
+        }
+        reference back()
+        {
+            MYSTL_DEBUG(!empty());
+            return *(end() - 1);
+        }
+        const_reference back() const
+        {
+            MYSTL_DEBUG(!empty());
+            return *(end() - 1);
+        }
+        pointer data() noexcept { return begin(); }
+        const_pointer data() const noexcept { return begin(); }
+
+        /*********************修改容器的操作**************/
+        template <class... Args>
+        iterator emplace(const_iterator pos, Args &&...args);
+        template <class... Args>
+        void emplace_back(Args &&...args)
+        {
+            check_room(1);
+            mystl::construct(end(), mystl::forward<Args>(args)...);
+            ++this->size_;
+        }
+        void push_back(const value_type &value) { emplace_back(value); }
+        void push_back(value_type &&value) { emplace_back(mystl::move(value)); }
+        void pop_back()
+        {
+            MYSTL_DEBUG(!empty());
+            mystl::destroy(end() - 1);
+            --this->size_;
+        }
+
+        iterator insert(const_iterator pos, const value_type &value) { return emplace(pos, value); }
+        iterator insert(const_iterator pos, value_type &&value) { return emplace(pos, mystl::move(value)); }
+        iterator insert(const_iterator pos, size_type n, const value_type &value)
+        {
+            MYSTL_DEBUG(pos >= begin() && pos <= end());
+            return fill_insert(const_cast<iterator>(pos), n, value);
+        }
+        template <class Iter, typename std::enable_if<
+                                  mystl::is_input_iterator<Iter>::value, int>::type = 0>
+        iterator insert(const_iterator pos, Iter first, Iter last)
+        {
+            MYSTL_DEBUG(pos >= begin() && pos <= end() && !(last < first));
+            return copy_insert(const_cast<iterator>(pos), first, last);
+        }
+
+        iterator erase(const_iterator pos);
+        iterator erase(const_iterator first, const_iterator last);
+        void clear() noexcept
+        {
+            mystl::destroy(begin(), end());
+            this->size_ = 0;
+        }
+
+        void resize(size_type new_size) { resize(new_size, value_type()); }
+        void resize(size_type new_size, const value_type &value)
+        {
+            if (new_size < size())
+                erase(begin() + new_size, end());
+            else
+                fill_insert(end(), new_size - size(), value);
+        }
+        void reverse()
+        {
+            for (auto i = begin(), j = end(); i < j;)
+                mystl::iter_swap(i++, --j);
+        }
+
+        // 没有缓冲区可以交换，逐个交换公共部分，再把多出的元素移动过去
+        void swap(static_vector &rhs);
+
+    private:
+        // 还能否再放入 n 个元素
+        void check_room(size_type n) const
+        {
+            check_room(n, std::integral_constant<bool, Checked>());
+        }
+        void check_room(size_type n, std::true_type) const
+        {
+            THROW_LENGTH_ERROR_IF(n > N - size(), "static_vector<T, N> capacity exceeded");
+        }
+        void check_room(size_type n, std::false_type) const noexcept
+        {
+            MYSTL_DEBUG(n <= N - size());
+            (void)n;
+        }
+
+        iterator fill_insert(iterator pos, size_type n, const value_type &value);
+        template <class IIter>
+        iterator copy_insert(iterator pos, IIter first, IIter last);
+    };
+
+    template <class T, size_t N>
+    using unchecked_static_vector = static_vector<T, N, false>;
+
+    /****************************************************************************************/
+    template <class T, size_t N, bool Checked>
+    template <class... Args>
+    typename static_vector<T, N, Checked>::iterator
+    static_vector<T, N, Checked>::emplace(const_iterator pos, Args &&...args)
+    {
+        MYSTL_DEBUG(pos >= begin() && pos <= end());
+        check_room(1);
+        iterator xpos = const_cast<iterator>(pos);
+        if (xpos == end())
+        {
+            mystl::construct(end(), mystl::forward<Args>(args)...);
+            ++this->size_;
+        }
+        else
+        {
+            value_type value(mystl::forward<Args>(args)...); // 参数可能引用将被移动的元素
+            mystl::construct(end(), mystl::move(*(end() - 1)));
+            ++this->size_;
+            mystl::move_backward(xpos, end() - 2, end() - 1);
+            *xpos = mystl::move(value);
+        }
+        return xpos;
+    }
+
+    template <class T, size_t N, bool Checked>
+    typename static_vector<T, N, Checked>::iterator
+    static_vector<T, N, Checked>::erase(const_iterator pos)
+    {
+        MYSTL_DEBUG(pos >= begin() && pos < end());
+        iterator xpos = const_cast<iterator>(pos);
+        mystl::move(xpos + 1, end(), xpos);
+        pop_back();
+        return xpos;
+    }
+
+    template <class T, size_t N, bool Checked>
+    typename static_vector<T, N, Checked>::iterator
+    static_vector<T, N, Checked>::erase(const_iterator first, const_iterator last)
+    {
+        MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
+        iterator xfirst = const_cast<iterator>(first);
+        iterator new_end = mystl::move(const_cast<iterator>(last), end(), xfirst);
+        mystl::destroy(new_end, end());
+        this->size_ = static_cast<size_type>(new_end - begin());
+        return xfirst;
+    }
+
+    template <class T, size_t N, bool Checked>
+    void static_vector<T, N, Checked>::swap(static_vector &rhs)
+    {
+        if (this == &rhs)
+            return;
+        static_vector &small = size() < rhs.size() ? *this : rhs;
+        static_vector &large = size() < rhs.size() ? rhs : *this;
+        const size_type common = small.size();
+        for (size_type i = 0; i < common; ++i)
+            mystl::swap(small[i], large[i]);
+        mystl::uninitialized_move(large.begin() + common, large.end(), small.end());
+        small.size_ = large.size();
+        mystl::destroy(large.begin() + common, large.end());
+        large.size_ = common;
+    }
+
+    // 与 vector::fill_insert 备用空间足够时的分支相同
+    template <class T, size_t N, bool Checked>
+    typename static_vector<T, N, Checked>::iterator
+    static_vector<T, N, Checked>::fill_insert(iterator pos, size_type n, const value_type &value)
+    {
+        if (n == 0)
+            return pos;
+        check_room(n);
+        const value_type value_copy = value; // 避免被覆盖
+        const size_type after_elems = end() - pos;
+        auto old_end = end();
+        if (after_elems > n)
+        {
+            mystl::uninitialized_move(end() - n, end(), end());
+            this->size_ += n;
+            mystl::move_backward(pos, old_end - n, old_end);
+            mystl::fill_n(pos, n, value_copy);
+        }
+        else
+        {
+            this->size_ = mystl::uninitialized_fill_n(end(), n - after_elems, value_copy) - begin();
+            this->size_ = mystl::uninitialized_move(pos, old_end, end()) - begin();
+            mystl::fill_n(pos, after_elems, value_copy);
+        }
+        return pos;
+    }
+
+    // 与 vector::copy_insert 备用空间足够时的分支相同
+    template <class T, size_t N, bool Checked>
+    template <class IIter>
+    typename static_vector<T, N, Checked>::iterator
+    static_vector<T, N, Checked>::copy_insert(iterator pos, IIter first, IIter last)
+    {
+        if (first == last)
+            return pos;
+        const size_type n = static_cast<size_type>(mystl::distance(first, last));
+        check_room(n);
+        const size_type after_elems = end() - pos;
+        auto old_end = end();
+        if (after_elems > n)
+        {
+            this->size_ = mystl::uninitialized_move(end() - n, end(), end()) - begin();
+            mystl::move_backward(pos, old_end - n, old_end);
+            mystl::copy(first, last, pos);
+        }
+        else
+        {
+            auto mid = first;
+            mystl::advance(mid, after_elems);
+            this->size_ = mystl::uninitialized_copy(mid, last, end()) - begin();
+            this->size_ = mystl::uninitialized_move(pos, old_end, end()) - begin();
+            mystl::copy(first, mid, pos);
+        }
+        return pos;
+    }
+
+    /*****************************运算符重载*******************************/
+    template <class T, size_t N, bool C>
+    bool operator==(const static_vector<T, N, C> &lhs, const static_vector<T, N, C> &rhs)
+    {
+        return lhs.size() == rhs.size() &&
+               mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+    template <class T, size_t N, bool C>
+    bool operator<(const static_vector<T, N, C> &lhs, const static_vector<T, N, C> &rhs)
+    {
+        return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+    template <class T, size_t N, bool C>
+    bool operator!=(const static_vector<T, N, C> &lhs, const static_vector<T, N, C> &rhs)
+    {
+        return !(lhs == rhs);
+    }
+    template <class T, size_t N, bool C>
+    bool operator>(const static_vector<T, N, C> &lhs, const static_vector<T, N, C> &rhs)
+    {
+        return rhs < lhs;
+    }
+    template <class T, size_t N, bool C>
+    bool operator<=(const static_vector<T, N, C> &lhs, const static_vector<T, N, C> &rhs)
+    {
+        return !(rhs < lhs);
+    }
+    template <class T, size_t N, bool C>
+    bool operator>=(const static_vector<T, N, C> &lhs, const static_vector<T, N, C> &rhs)
+    {
+        return !(lhs < rhs);
+    }
+    template <class T, size_t N, bool C>
+    void swap(static_vector<T, N, C> &lhs, static_vector<T, N, C> &rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    // 只有元素个数和元素本身
+    template <class T, size_t N, bool C>
+    struct is_trivially_relocatable<static_vector<T, N, C>> : is_trivially_relocatable<T>
+    {
+    };
+}
+
+#endif
@@ -11,6 +11,14 @@ namespace mystl
     using wstring = mystl::basic_string<wchar_t>;
     using u16string = mystl::basic_string<char16_t>;
     using u32string = mystl::basic_string<char32_t>;
+
+    namespace pmr
+    {
+        using string = pmr::basic_string<char>;
+        using wstring = pmr::basic_string<wchar_t>;
+        using u16string = pmr::basic_string<char16_t>;
+        using u32string = pmr::basic_string<char32_t>;
+    }
 }
 
 #endif
\ No newline at end of file
@@ -3,10 +3,13 @@
 
 #include <initializer_list>
 
-#include "iterator.h"
-#include "memory.h"
-#include "util.h"
-#include "exceptdef.h"
+#include "base/iterator.h"
+#include "base/memory.h"
+#include "base/allocator_traits.h"
+#include "base/growth_policy.h"
+#include "base/memory_resource.h"
+#include "base/util.h"
+#include "base/exceptdef.h"
 
 namespace mystl
 {
@@ -63,13 +66,13 @@ namespace mystl
     // erase(const_iterator)、erase(const_iterator first,const_iterator last);
     // clear()
     // resize(size_type)、resize(size_type,const value_type&)
+    // resize_default_init(size_type)、resize_and_overwrite(size_type,Operation)
     // reverse()
     // swap(vector&)
     /****************************************************************/
     /****************************************************************/
     // 私有的辅助函数有：
     /*********************初始化：init*****************/
-    // try_init()
     // init_space(size_type,size_type)
     // fill_init(size_type,const value_type& value)
     // range_init(Iter first, Iter last)
@@ -82,26 +85,37 @@ namespace mystl
     // copy_insert(iterator pos, IIter first, IIter last)
     // reinsert(size_type)
 
-    template <class T>
-    class vector
+    template <class T, size_t N, class Alloc>
+    class small_vector;
+
+    template <class T, class Alloc = mystl::allocator<T>, class Growth = mystl::growth_1_5x>
+    class vector : private mystl::allocator_holder<Alloc>, private mystl::allocator_holder<Growth>
     {
         // 静态断言
-        static_assert(!std::is_same<bool, T>::value, "vector<bool> is abandone in mystl");
+        static_assert(!std::is_same<bool, T>::value, "vector<bool> is abandoned in mystl, use mystl::bit_vector instead");
+
+        // small_vector 在内部缓冲区与堆之间搬移时需要直接改写三个指针
+        template <class U, size_t N, class A>
+        friend class small_vector;
 
     public:
         // vector的分配器类别定义
-        typedef mystl::allocator<T> allocator_type;
-        typedef mystl::allocator<T> data_allocator;
+        typedef Alloc allocator_type;
+        typedef Growth growth_policy_type;
+        typedef mystl::allocator_traits<Alloc> alloc_traits;
 
         // 必要接口
 
-        typedef typename allocator_type::value value_type;
-        typedef typename allocator_type::pointer pointer;
-        typedef typename allocator_type::const_pointer const_pointer;
-        typedef typename allocator_type::reference reference;
-        typedef typename allocator_type::const_reference const_reference;
-        typedef typename allocator_type::size_type size_type;
-        typedef typename allocator_type::difference_type difference_type;
+        typedef typename alloc_traits::value_type value_type;
+        typedef typename alloc_traits::pointer pointer;
+        typedef typename alloc_traits::const_pointer const_pointer;
+        typedef value_type &reference;
+        typedef const value_type &const_reference;
+        typedef typename alloc_traits::size_type size_type;
+        typedef typename alloc_traits::difference_type difference_type;
+
+        static_assert(std::is_same<T, value_type>::value,
+                      "Alloc::value_type must be same as T");
 
         // 定义迭代器
         typedef value_type *iterator;
@@ -110,57 +124,113 @@ namespace mystl
         typedef mystl::reverse_iterator<const_iterator> const_reverse_iterator;
 
     private:
-        iterator begin_;    // 表示当前使用的空间的头部
-        iterator end_;      // 表示当前使用空间的尾部
-        iterator capacity_; // 表示当前储存空间的尾部
+        // 配置器和扩容策略存放在基类中，空的配置器和策略不占空间
+        typedef mystl::allocator_holder<Alloc> alloc_base;
+        typedef mystl::allocator_holder<Growth> growth_base;
+
+        // 移动赋值能否直接接管对方的缓冲区
+        static constexpr bool move_assign_steals =
+            alloc_traits::propagate_on_container_move_assignment::value ||
+            alloc_traits::is_always_equal::value;
+
+        // 元素能否按字节搬移：扩容时 memcpy 到新区块，插入、删除时 memmove，旧对象不再析构
+        static constexpr bool relocatable = mystl::is_trivially_relocatable<T>::value;
+
+        // 扩容与收缩时能否让配置器直接改变区块大小（例如 mremap），元素必须可以按字节搬移
+        static constexpr bool can_remap = relocatable && mystl::has_reallocate<Alloc>::value;
+
+    private:
+        // 使用配置器的 pointer 保存，配置器使用 offset_ptr 时 vector 可以放在共享内存中
+        pointer begin_;    // 表示当前使用的空间的头部
+        pointer end_;      // 表示当前使用空间的尾部
+        pointer capacity_; // 表示当前储存空间的尾部
 
     public:
         //主要的公有成员函数：
-        // 默认构造函数
+        // 默认构造函数，第一次插入时才分配空间
         vector() noexcept
+            : alloc_base(), begin_(nullptr), end_(nullptr), capacity_(nullptr)
+        {
+        }
+        // 指定空间配置器，例如 pmr::vector<int> v(&arena)
+        explicit vector(const allocator_type &alloc) noexcept
+            : alloc_base(alloc), begin_(nullptr), end_(nullptr), capacity_(nullptr)
         {
-            try_init();
         }
         // 参数构造函数：vector(size_type)，禁止隐式类型转换
-        explicit vector(size_type n)
+        explicit vector(size_type n, const allocator_type &alloc = allocator_type())
+            : alloc_base(alloc)
         {
             fill_init(n, value_type());
         }
-        vector(size_type n, value_type &value)
+        vector(size_type n, const value_type &value,
+               const allocator_type &alloc = allocator_type())
+            : alloc_base(alloc)
         {
             fill_init(n, value);
         }
         template <class Iter, typename std::enable_if<
                                   mystl::is_input_iterator<Iter>::value, int>::type = 0>
-        vector(Iter first, Iter last)
+        vector(Iter first, Iter last, const allocator_type &alloc = allocator_type())
+            : alloc_base(alloc)
         {
             MYSTL_DEBUG(!(first < first));
             range_init(first, last);
         }
-        // 复制构造函数
+        // 复制构造函数，新容器的配置器由 select_on_container_copy_construction 决定
         vector(const vector &rhs)
+            : alloc_base(alloc_traits::select_on_container_copy_construction(rhs.data_alloc())),
+              growth_base()
+        {
+            range_init(rhs.begin(), rhs.end());
+        }
+        vector(const vector &rhs, const allocator_type &alloc)
+            : alloc_base(alloc)
         {
-            range_init(rhs.begin_, rhs.end_);
+            range_init(rhs.begin(), rhs.end());
         }
-        // 右值拷贝
+        // 右值拷贝，空间配置器随缓冲区一起转移
         vector(vector &&rhs) noexcept
-            : begin_(rhs.begin_), end_(rhs.end_), capacity_(rhs.capacity_)
+            : alloc_base(rhs.data_alloc()), growth_base(),
+              begin_(rhs.begin_), end_(rhs.end_), capacity_(rhs.capacity_)
         {
             rhs.begin_ = nullptr;
             rhs.end_ = nullptr;
-            rhs.capacoty_ = nullptr;
+            rhs.capacity_ = nullptr;
+        }
+        // 指定配置器的右值拷贝，配置器不相等时逐个移动元素
+        vector(vector &&rhs, const allocator_type &alloc)
+            : alloc_base(alloc)
+        {
+            if (data_alloc() == rhs.data_alloc())
+            {
+                begin_ = rhs.begin_;
+                end_ = rhs.end_;
+                capacity_ = rhs.capacity_;
+                rhs.begin_ = nullptr;
+                rhs.end_ = nullptr;
+                rhs.capacity_ = nullptr;
+            }
+            else
+            {
+                const size_type n = rhs.size();
+                init_space(n, n);
+                mystl::uninitialized_move(rhs.begin(), rhs.end(), begin());
+            }
         }
         // 初始化列表构造
-        vector(std::initializer_list<value_type> ilist)
+        vector(std::initializer_list<value_type> ilist,
+               const allocator_type &alloc = allocator_type())
+            : alloc_base(alloc)
         {
-            range_list(ilist.begin(), ilist.end());
+            range_init(ilist.begin(), ilist.end());
         }
         /*********************运算符重载*******************/
         vector &operator=(const vector &rhs);
-        vector &operator=(vector &&rhs) noexcept;
+        vector &operator=(vector &&rhs) noexcept(move_assign_steals);
         vector &operator=(std::initializer_list<value_type> ilist)
         {
-            vector tmp(ilist.begin(), ilist.end());
+            vector tmp(ilist.begin(), ilist.end(), data_alloc());
             swap(tmp);
             return *this;
         }
@@ -170,6 +240,13 @@ namespace mystl
             destroy_and_recover(begin_, end_, capacity_ - begin_);
             begin_ = end_ = capacity_ = nullptr;
         }
+        allocator_type get_allocator() const
+        {
+            return data_alloc();
+        }
+        // 扩容策略，使用 growth_stats 时可以从中读取重新分配的统计
+        growth_policy_type &get_growth_policy() noexcept { return growth_base::get(); }
+        const growth_policy_type &get_growth_policy() const noexcept { return growth_base::get(); }
         /*********************迭代器**********************/
         iterator begin() noexcept
         {
@@ -190,19 +267,19 @@ namespace mystl
         // rbegin()、rend()：各2种
         reverse_iterator rbegin() noexcept
         {
-            return reverse_iterator(end();)
+            return reverse_iterator(end());
         }
-        const reverse_iterator rbegin() const noexcept
+        const_reverse_iterator rbegin() const noexcept
         {
-            return const_reverse_iterator(end();)
+            return const_reverse_iterator(end());
         }
         reverse_iterator rend() noexcept
         {
-            return reverse_iterator(begin();)
+            return reverse_iterator(begin());
         }
-        const reverse_iterator rend() const noexcept
+        const_reverse_iterator rend() const noexcept
         {
-            return const_reverse_iterator(begin();)
+            return const_reverse_iterator(begin());
         }
         // cbegin()、cend()、crbegin()、crend()
         const_iterator cbegin() const noexcept
@@ -217,9 +294,9 @@ namespace mystl
         {
             return rbegin();
         }
-        const reverse_iterator crend() const noexcept
+        const_reverse_iterator crend() const noexcept
         {
-            return begin();
+            return rend();
         }
         /*********************容量操作********************/
         bool empty() const noexcept
@@ -234,23 +311,39 @@ namespace mystl
         {
             return static_cast<size_type>(-1) / sizeof(T);
         }
+        size_type capacity() const noexcept
+        {
+            return static_cast<size_type>(capacity_ - begin_);
+        }
+        void reserve(size_type n);
+        void shrink_to_fit();
         /*********************访问元素操作****************/
         reference operator[](size_type n)
         {
             MYSTL_DEBUG(n < size());
             return *(begin_ + n);
         }
-        reference operator[](size_type n) const
+        const_reference operator[](size_type n) const
         {
             MYSTL_DEBUG(n < size());
             return *(begin_ + n);
         }
-        reference first()
+        reference at(size_type n)
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "vector<T>::at() subscript out of range");
+            return (*this)[n];
+        }
+        const_reference at(size_type n) const
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "vector<T>::at() subscript out of range");
+            return (*this)[n];
+        }
+        reference front()
         {
             MYSTL_DEBUG(!empty());
             return *begin_;
         }
-        const_reference first() const
+        const_reference front() const
         {
             MYSTL_DEBUG(!empty());
             return *begin_;
@@ -265,6 +358,8 @@ namespace mystl
             MYSTL_DEBUG(!empty());
             return *(end_ - 1);
         }
+        pointer data() noexcept { return begin_; }
+        const_pointer data() const noexcept { return begin_; }
 
         // emplace利用了右值拷贝的思想，可以直接利用参数调用构造函数生成临时对象
         template <class... Args>
@@ -281,16 +376,16 @@ namespace mystl
         void pop_back()
         {
             MYSTL_DEBUG(!empty());
-            data_allocator::destroy(end_ - 1);
+            alloc_traits::destroy(data_alloc(), end() - 1);
             --end_;
         }
 
         iterator insert(const_iterator pos, const value_type &value);
         iterator insert(const_iterator pos, value_type &&value)
         {
-            return emplace(pos, mystl::move(value));)
+            return emplace(pos, mystl::move(value));
         }
-        iterator insert(const_iterator pos, size_type n, value_type &val)
+        iterator insert(const_iterator pos, size_type n, const value_type &value)
         {
             MYSTL_DEBUG(pos >= begin() && pos <= end());
             return fill_insert(const_cast<iterator>(pos), n, value);
@@ -299,7 +394,7 @@ namespace mystl
                                   mystl::is_input_iterator<Iter>::value, int>::type = 0>
         void insert(const_iterator pos, Iter first, Iter last)
         {
-            MYSTL_DEBUG(pos >= begin && pos <= end() && !(lst < first));
+            MYSTL_DEBUG(pos >= begin() && pos <= end() && !(last < first));
             copy_insert(const_cast<iterator>(pos), first, last);
         }
 
@@ -311,27 +406,51 @@ namespace mystl
         // resize() / reverse
         void resize(size_type new_size) { return resize(new_size, value_type()); }
         void resize(size_type new_size, const value_type &value);
-        void reverse() { mystl::reverse(begin(), end()); }
+        // 新增的元素默认初始化，平凡类型不清零，用作 I/O 缓冲区时由调用者随后写入
+        void resize_default_init(size_type new_size);
+        // 先按 resize_default_init 扩到 new_size，再调用 op(data(), new_size) 写入内容，
+        // op 返回最终的大小（不超过 new_size），之后的元素被销毁
+        template <class Operation>
+        void resize_and_overwrite(size_type new_size, Operation op);
+        void reverse()
+        {
+            for (auto i = begin(), j = end(); i < j;)
+                mystl::iter_swap(i++, --j);
+        }
 
         // swap(vector&)
         void swap(vector &rhs) noexcept;
         /****************************************************************/
     private:
         // 私有的辅助函数有：
+        // 取得配置器
+        allocator_type &data_alloc() noexcept { return alloc_base::get(); }
+        const allocator_type &data_alloc() const noexcept { return alloc_base::get(); }
+
         // init / destroy
-        void try_init() noexcept;
         void init_space(size_type size, size_type capacity_);
         void fill_init(size_type n, const value_type &value);
         template <class Iter>
         void range_init(Iter first, Iter last);
         void destroy_and_recover(iterator first, iterator last, size_type n);
+        void relocate_into(iterator new_begin, size_type new_cap, size_type off, size_type n) noexcept;
+        iterator open_gap(iterator pos, size_type n) noexcept;
+        void close_gap(iterator pos, size_type n) noexcept;
 
         //计算需要成长的大小
         size_type get_new_cap(size_type add_size);
+        // 每次重新分配后通知扩容策略，moved 为搬移的元素个数
+        void note_reallocate(size_type moved) noexcept
+        {
+            growth_base::get().on_reallocate(moved * sizeof(T));
+        }
+        bool try_remap(size_type new_cap);
 
         /*********************reallocate******************/
         template <class... Args>
         void reallocate_emplace(iterator pos, Args &&...args);
+        template <class... Args>
+        void reallocate_emplace_aux(iterator pos, Args &&...args);
         void reallocate_insert(iterator pos, const value_type &value);
 
         // insert
@@ -345,63 +464,95 @@ namespace mystl
     /****************************************************************************************/
 
     // 复制赋值操作符
-    template <class T>
-    vector<T> &vector<T>::operator=(const vector &rhs)
+    template <class T, class Alloc, class Growth>
+    vector<T, Alloc, Growth> &vector<T, Alloc, Growth>::operator=(const vector &rhs)
     {
         if (this != &rhs)
         {
+            // 需要传播且配置器不同时，旧的缓冲区必须用旧的配置器先释放
+            if (alloc_traits::propagate_on_container_copy_assignment::value &&
+                !(data_alloc() == rhs.data_alloc()))
+            {
+                destroy_and_recover(begin_, end_, capacity_ - begin_);
+                begin_ = end_ = capacity_ = nullptr;
+            }
+            alloc_traits::copy_assign(data_alloc(), rhs.data_alloc());
             const auto len = rhs.size();
             if (len > capacity())
             {
-                vector tmp(rhs.begin(), rhs.end());
+                vector tmp(rhs.begin(), rhs.end(), data_alloc());
                 swap(tmp);
             }
             else if (size() >= len)
             {
                 auto i = mystl::copy(rhs.begin(), rhs.end(), begin());
-                data_allocator::destroy(i, end_);
+                alloc_traits::destroy(data_alloc(), i, end());
                 end_ = begin_ + len;
             }
             else
             {
-                mystl::copy(rhs.begin(), rhs.end(), begin_);
-                mystl::uninitialized_copy(rhs.begin() + size(), rhs.end(), end_);
+                mystl::copy(rhs.begin(), rhs.begin() + size(), begin());
+                end_ = mystl::uninitialized_copy(rhs.begin() + size(), rhs.end(), end());
             }
         }
+        return *this;
     }
     // 移动赋值操作符
-    template <class T>
-    vector<T> &vector<T>::operator=(vector &&rhs) noexcept
+    // 配置器会传播或相等时直接接管 rhs 的缓冲区，否则只能在自己的空间上逐个移动元素
+    template <class T, class Alloc, class Growth>
+    vector<T, Alloc, Growth> &vector<T, Alloc, Growth>::operator=(vector &&rhs) noexcept(move_assign_steals)
     {
+        if (this == &rhs)
+            return *this;
         destroy_and_recover(begin_, end_, capacity_ - begin_);
-        begin_ = rhs.begin_;
-        end_ = rhs.end_;
-        capacity_ = rhs.capacity_;
-        rhs.begin_ = nullptr;
-        rhs.end_ = nullptr;
-        rhs.capacity_ = nullptr;
+        if (move_assign_steals || data_alloc() == rhs.data_alloc())
+        {
+            alloc_traits::move_assign(data_alloc(), rhs.data_alloc());
+            begin_ = rhs.begin_;
+            end_ = rhs.end_;
+            capacity_ = rhs.capacity_;
+            rhs.begin_ = nullptr;
+            rhs.end_ = nullptr;
+            rhs.capacity_ = nullptr;
+        }
+        else
+        {
+            const size_type n = rhs.size();
+            init_space(n, n);
+            mystl::uninitialized_move(rhs.begin(), rhs.end(), begin());
+            rhs.clear();
+        }
         return *this;
     }
     // 在pos位置就地构造元素，避免额外的复制或移动开销
-    template <class T>
+    template <class T, class Alloc, class Growth>
     template <class... Args>
-    typename vector<T>::iterator
-    vector<T>::emplace(const_iterator pos, Args &&...args)
+    typename vector<T, Alloc, Growth>::iterator
+    vector<T, Alloc, Growth>::emplace(const_iterator pos, Args &&...args)
     {
         MYSTL_DEBUG(pos >= begin() && pos <= end());
         iterator xpos = const_cast<iterator>(pos);
         const size_type n = xpos - begin_;
         if (end_ != capacity_ && xpos == end_)
         {
-            data_allocator::construct(mystl::address_of(*end_), mystl::forward<Args>(args)...);
+            alloc_traits::construct(data_alloc(), mystl::address_of(*end_), mystl::forward<Args>(args)...);
             ++end_;
         }
+        else if (relocatable && end_ != capacity_)
+        {
+            // 参数可能引用后移的元素，先在旁边构造好，再按字节放进空位
+            alignas(T) unsigned char raw[sizeof(T)];
+            T *tmp = reinterpret_cast<T *>(raw);
+            alloc_traits::construct(data_alloc(), tmp, mystl::forward<Args>(args)...);
+            open_gap(xpos, 1);
+            mystl::uninitialized_relocate(tmp, tmp + 1, xpos);
+        }
         else if (end_ != capacity_)
         {
-            auto new_end = end_;
-            data_allocator::construct(mystl::address_of(*end_), (*end_ - 1));
+            auto new_end = end();
+            alloc_traits::construct(data_alloc(), mystl::address_of(*end_), *(end_ - 1));
             ++new_end;
-            mystl::copy_backward(xpos, end_ - 1, end_); //后退
+            mystl::copy_backward(xpos, end() - 1, end()); //后退
             *xpos = value_type(mystl::forward<Args>(args)...);
             end_ = new_end;
         }
@@ -411,59 +562,61 @@ namespace mystl
         }
         return begin_ + n;
     }
-    template <class T>
+    template <class T, class Alloc, class Growth>
     template <class... Args>
-    void vector<T>::emplace_back(Args &&...args)
+    void vector<T, Alloc, Growth>::emplace_back(Args &&...args)
     {
         if (end_ < capacity_)
         {
-            data_allocator::construct(mystl::address_of(*end_), mystl::forward<Args>(args)...);
+            alloc_traits::construct(data_alloc(), mystl::address_of(*end_), mystl::forward<Args>(args)...);
             ++end_;
         }
-        else if (end_ != capacity_)
+        else
         {
             reallocate_emplace(end_, mystl::forward<Args>(args)...);
         }
     }
-    template <class T>
-    void vector<T>::push_back(const value_type &value)
+    template <class T, class Alloc, class Growth>
+    void vector<T, Alloc, Growth>::push_back(const value_type &value)
     {
         if (end_ != capacity_)
         {
-            data_allocator::construct(mystl::address_of(*end_), value);
+            alloc_traits::construct(data_alloc(), mystl::address_of(*end_), value);
+            ++end_;
         }
         else
         {
             reallocate_insert(end_, value);
         }
     }
-    template <class T>
-    void pop_back()
-    {
-        MYSTL_DEBUG(!empty());
-        data_allocator::destroy(end_ - 1);
-        --end_;
-    }
     // 在pos处插入元素
-    template <class T>
-    typename vector<T>::iterator
-    vector<T>::insert(const_iterator pos, const value_type &value)
+    template <class T, class Alloc, class Growth>
+    typename vector<T, Alloc, Growth>::iterator
+    vector<T, Alloc, Growth>::insert(const_iterator pos, const value_type &value)
     {
         MYSTL_DEBUG(pos >= begin() && pos <= end());
         iterator xpos = const_cast<iterator>(pos);
         const size_type n = pos - begin_;
-        if (end_ != cap_ && xpos == end_)
+        if (end_ != capacity_ && xpos == end_)
         {
-            data_allocator::construct(mystl::address_of(*end_), value);
+            alloc_traits::construct(data_alloc(), mystl::address_of(*end_), value);
             ++end_;
         }
-        else if (end_ != cap_)
+        else if (relocatable && end_ != capacity_)
+        {
+            alignas(T) unsigned char raw[sizeof(T)];
+            T *tmp = reinterpret_cast<T *>(raw);
+            alloc_traits::construct(data_alloc(), tmp, value);
+            open_gap(xpos, 1);
+            mystl::uninitialized_relocate(tmp, tmp + 1, xpos);
+        }
+        else if (end_ != capacity_)
         {
-            auto new_end = end_;
-            data_allocator::construct(mystl::address_of(*end_), *(end_ - 1));
+            auto new_end = end();
+            alloc_traits::construct(data_alloc(), mystl::address_of(*end_), *(end_ - 1));
             ++new_end;
             auto value_copy = value; // 避免元素因以下复制操作而被改变
-            mystl::copy_backward(xpos, end_ - 1, end_);
+            mystl::copy_backward(xpos, end() - 1, end());
             *xpos = mystl::move(value_copy);
             end_ = new_end;
         }
@@ -473,32 +626,80 @@ namespace mystl
         }
         return begin_ + n;
     }
+    // 预留空间大小，当原容量小于要求大小时，才会重新分配
+    template <class T, class Alloc, class Growth>
+    void vector<T, Alloc, Growth>::reserve(size_type n)
+    {
+        if (capacity() < n)
+        {
+            THROW_LENGTH_ERROR_IF(n > max_size(),
+                                  "n can not larger than max_size() in vector<T>::reserve(n)");
+            if (try_remap(n))
+                return;
+            const auto old_size = size();
+            const auto block = alloc_traits::allocate_at_least(data_alloc(), n);
+            auto tmp = mystl::to_address(block.ptr);
+            if (relocatable)
+            {
+                relocate_into(tmp, block.count, old_size, 0);
+                return;
+            }
+            mystl::uninitialized_move(begin(), end(), tmp);
+            note_reallocate(size());
+            destroy_and_recover(begin_, end_, capacity_ - begin_);
+            begin_ = tmp;
+            end_ = tmp + old_size;
+            capacity_ = begin_ + block.count;
+        }
+    }
+    // 放弃多余的容量
+    template <class T, class Alloc, class Growth>
+    void vector<T, Alloc, Growth>::shrink_to_fit()
+    {
+        if (end_ < capacity_)
+        {
+            reinsert(size());
+        }
+    }
     // 删除pos位置上的元素
-    template <class T>
-    typename vector<T>::iterator
-    vector<T>::erase(const_iterator pos)
+    template <class T, class Alloc, class Growth>
+    typename vector<T, Alloc, Growth>::iterator
+    vector<T, Alloc, Growth>::erase(const_iterator pos)
     {
         MYSTL_DEBUG(pos >= begin() && pos < end());
         iterator xpos = begin_ + (pos - begin());
-        mystl::move(xpos + 1, end_, xpos);
-        data_allocator::destroy(end_ - 1);
+        if (relocatable)
+        {
+            alloc_traits::destroy(data_alloc(), xpos);
+            close_gap(xpos, 1);
+            return xpos;
+        }
+        mystl::move(xpos + 1, end(), xpos);
+        alloc_traits::destroy(data_alloc(), end() - 1);
         --end_;
         return xpos;
     }
     // 删除[first,last)上的元素
-    template <class T>
-    typename vector<T>::iterator
-    vector<T>::erase(const_iterator first, const_iterator last)
+    template <class T, class Alloc, class Growth>
+    typename vector<T, Alloc, Growth>::iterator
+    vector<T, Alloc, Growth>::erase(const_iterator first, const_iterator last)
     {
         MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
         const auto n = first - begin();
         iterator r = begin_ + n;
-        data_allocator::destroy(mystl::move(last, end_, r), end_);
+        if (relocatable)
+        {
+            alloc_traits::destroy(data_alloc(), r, r + (last - first));
+            close_gap(r, static_cast<size_type>(last - first));
+            return r;
+        }
+        alloc_traits::destroy(data_alloc(), mystl::move(const_cast<iterator>(last), end(), r), end());
+        end_ = end_ - (last - first);
         return begin_ + n;
     }
     // 重置容器大小
-    template <class T>
-    void vector<T>::resize(size_type new_size, const value_type &value)
+    template <class T, class Alloc, class Growth>
+    void vector<T, Alloc, Growth>::resize(size_type new_size, const value_type &value)
     {
         if (new_size < size())
         {
@@ -509,185 +710,335 @@ namespace mystl
             insert(end(), new_size - size(), value);
         }
     }
+    // 重置容器大小，新增的元素默认初始化
+    // 直接 placement new 而不经过 alloc_traits::construct，否则平凡类型也会被值初始化
+    template <class T, class Alloc, class Growth>
+    void vector<T, Alloc, Growth>::resize_default_init(size_type new_size)
+    {
+        const auto old_size = size();
+        if (new_size <= old_size)
+        {
+            erase(begin() + new_size, end());
+            return;
+        }
+        if (new_size > capacity())
+        {
+            // 按扩容策略增长，反复调用时与 push_back 一样是均摊 O(1) 的
+            reserve(get_new_cap(new_size - capacity()));
+        }
+        mystl::uninitialized_default_construct(mystl::to_address(end_), mystl::to_address(begin_ + new_size));
+        end_ = begin_ + new_size;
+    }
+    // 扩到 new_size 后由 op 写入内容，op 返回最终的大小
+    template <class T, class Alloc, class Growth>
+    template <class Operation>
+    void vector<T, Alloc, Growth>::resize_and_overwrite(size_type new_size, Operation op)
+    {
+        resize_default_init(new_size);
+        const auto result = static_cast<size_type>(op(mystl::to_address(begin_), new_size));
+        MYSTL_DEBUG(result <= new_size);
+        erase(begin() + result, end());
+    }
     // 与另一个vector交换
-    template <class T>
-    void vector<T>::swap(vector<T> &rhs) noexcept
+    template <class T, class Alloc, class Growth>
+    void vector<T, Alloc, Growth>::swap(vector<T, Alloc, Growth> &rhs) noexcept
     {
+        // 配置器不传播时，只有相等的配置器才能交换缓冲区
+        MYSTL_DEBUG(alloc_traits::propagate_on_container_swap::value ||
+                    data_alloc() == rhs.data_alloc());
         if (this != &rhs)
         {
+            alloc_traits::swap(data_alloc(), rhs.data_alloc());
             mystl::swap(begin_, rhs.begin_);
             mystl::swap(end_, rhs.end_);
             mystl::swap(capacity_, rhs.capacity_);
         }
     }
     /********************************私有的互助函数***********************************/
-    template <class T>
-    void vector<T>::try_init() noexcept
+    template <class T, class Alloc, class Growth>
+    void vector<T, Alloc, Growth>::init_space(size_type size, size_type capacity)
     {
-        try
-        {
-            begin_ = data_allocator::allocate(16);
-            end_ = begin_;
-            capacity_ = begin_ + 16;
-        }
-        catch (...)
-        {
-            begin_ = nullptr;
-            end_ = nullptr;
-            capacity_ = nullptr;
-        }
+        begin_ = end_ = capacity_ = nullptr;
+        if (capacity == 0)
+            return;
+        // 分配失败时异常直接传出去，调用方不会再往空指针上构造元素
+        const auto block = alloc_traits::allocate_at_least(data_alloc(), capacity);
+        begin_ = block.ptr;
+        end_ = begin_ + size;
+        capacity_ = begin_ + block.count;
     }
-    template <class T>
-    void vector<T>::init_space(size_type size, size_type capacity)
+    template <class T, class Alloc, class Growth>
+    void vector<T, Alloc, Growth>::fill_init(size_type n, const value_type &value)
     {
-        try
-        {
-            begin_ = data_allocator::allocate(capacity);
-            end_ = begin_ + size;
-            capacity_ = begin_ + capacity_;
-        }
-        catch (...)
-        {
-            begin_ = nullptr;
-            end_ = nullptr;
-            capacity_ = nullptr;
-        }
+        init_space(n, n);
+        mystl::uninitialized_fill_n(begin(), n, value);
     }
-    template <class T>
-    void vector<T>::fill_init(size_type size, const value_type &value)
+    template <class T, class Alloc, class Growth>
+    template <class Iter>
+    void vector<T, Alloc, Growth>::range_init(Iter first, Iter last)
     {
-        const size_type init_size = mystl::max(static_cast<size_type>(16), n);
-        init_space(n, init_size);
-        mystl::uninitialized_fill_n(begin_, n, value);
+        const size_type n = static_cast<size_type>(last - first);
+        init_space(n, n);
+        mystl::uninitialized_copy(first, last, begin());
     }
-    template <class T>
-    template <class Iter>
-    void vector<T>::range_init(Iter first, Iter last)
+    template <class T, class Alloc, class Growth>
+    void vector<T, Alloc, Growth>::destroy_and_recover(iterator first, iterator last, size_type n)
     {
-        const size_type init_size = mystl::max(static_cast<size_type>(last - first),
-                                               static_cast<size_type>(16));
-        init_space(static_cast<size_type>(last - first), init_size);
-        mystl::uninitialized_copy(first, last, begin_);
+        alloc_traits::destroy(data_alloc(), first, last);
+        alloc_traits::deallocate(data_alloc(), first, n);
     }
-    template <class T>
-    void vector<T>::destroy_and_recover(iterator first, iterator last, size_type n)
+    // 只用于 relocatable 的元素：新区块中下标 [off, off + n) 的新元素已经构造好，
+    // 把旧元素按字节搬到它们两侧，释放旧区块而不析构旧元素
+    template <class T, class Alloc, class Growth>
+    void vector<T, Alloc, Growth>::relocate_into(iterator new_begin, size_type new_cap,
+                                                 size_type off, size_type n) noexcept
     {
-        data_allocator::destroy(first, last);
-        data_allocator::deallocate(first, n);
+        const size_type old_size = size();
+        note_reallocate(old_size);
+        mystl::uninitialized_relocate(begin(), begin() + off, new_begin);
+        mystl::uninitialized_relocate(begin() + off, end(), new_begin + off + n);
+        alloc_traits::deallocate(data_alloc(), begin_, capacity());
+        begin_ = new_begin;
+        end_ = new_begin + old_size + n;
+        capacity_ = new_begin + new_cap;
+    }
+    // 只用于 relocatable 的元素：把 [pos, end) 后移 n 个位置，留出 n 个未初始化的空位
+    template <class T, class Alloc, class Growth>
+    typename vector<T, Alloc, Growth>::iterator
+    vector<T, Alloc, Growth>::open_gap(iterator pos, size_type n) noexcept
+    {
+        mystl::uninitialized_relocate(pos, end(), pos + n);
+        end_ += n;
+        return pos;
     }
-    template <class T>
-    typename vector<T>::size_type
-    vector<T>::get_new_cap(size_type add_size)
+    // open_gap 的逆操作，空位中的元素已经析构或尚未构造
+    template <class T, class Alloc, class Growth>
+    void vector<T, Alloc, Growth>::close_gap(iterator pos, size_type n) noexcept
+    {
+        mystl::uninitialized_relocate(pos + n, end(), pos);
+        end_ -= n;
+    }
+    template <class T, class Alloc, class Growth>
+    typename vector<T, Alloc, Growth>::size_type
+    vector<T, Alloc, Growth>::get_new_cap(size_type add_size)
     {
         const auto old_size = capacity();
         THROW_LENGTH_ERROR_IF(old_size > max_size() - add_size,
                               "vector<T>'s size too big");
-        // 1.5倍扩容还是2倍扩容各有各的好处
-        if (old_size > max_size() - old_size / 2)
+        // 扩容的倍数由 Growth 决定，结果限制在 [old_size + add_size, max_size()] 之间
+        const size_type required = old_size + add_size;
+        const size_type new_size = growth_base::get().next_capacity(old_size, required, max_size());
+        return mystl::max(mystl::min(new_size, max_size()), required);
+    }
+    // 让配置器把区块直接改为 new_cap 个元素，元素按字节保留，做不到时返回 false
+    template <class T, class Alloc, class Growth>
+    bool vector<T, Alloc, Growth>::try_remap(size_type new_cap)
+    {
+        if (!can_remap || begin_ == nullptr || new_cap < size())
+            return false;
+        const size_type old_size = size();
+        pointer p = alloc_traits::reallocate(data_alloc(), begin_, capacity(), new_cap);
+        if (p == nullptr)
+            return false;
+        begin_ = p;
+        end_ = begin_ + old_size;
+        capacity_ = begin_ + new_cap;
+        note_reallocate(0); // 页表搬移，没有复制元素
+        return true;
+    }
+    /*********************reallocate******************/
+    template <class T, class Alloc, class Growth>
+    template <class... Args>
+    void vector<T, Alloc, Growth>::reallocate_emplace(iterator pos, Args &&...args)
+    {
+        if (can_remap)
         {
-            return old_size + add_size > max_size() - 16
-                       ? old_size + add_size
-                       : old_size + add_size + 16;
+            // 参数可能引用旧缓冲区中的元素，先构造出来再改变区块
+            value_type value(mystl::forward<Args>(args)...);
+            const size_type n = pos - begin();
+            if (try_remap(get_new_cap(1)))
+                emplace(begin() + n, mystl::move(value));
+            else
+                reallocate_emplace_aux(pos, mystl::move(value));
+            return;
         }
-        const size_type new_size = (old_size == 0)
-                                       ? mystl::max(add_size, static_cast<size_type>(16))
-                                       : mystl::max(old_size + old_size / 2, old_size + add_size);
-        return new_size;
+        reallocate_emplace_aux(pos, mystl::forward<Args>(args)...);
     }
-    /*********************reallocate******************/
-    template <class T>
+    // 分配新的空间，把元素逐个移动过去
+    template <class T, class Alloc, class Growth>
     template <class... Args>
-    void vector<T>::reallocate_emplace(iterator pos, Args &&...args)
+    void vector<T, Alloc, Growth>::reallocate_emplace_aux(iterator pos, Args &&...args)
     {
-        const auto new_size = get_new_cap(1);
-        auto new_begin = data_allocator::allocate(new_size);
+        // 配置器实际给出的空间可能比请求的多，多出的部分也计入容量
+        const auto block = alloc_traits::allocate_at_least(data_alloc(), get_new_cap(1));
+        const auto new_size = block.count;
+        auto new_begin = mystl::to_address(block.ptr);
+        if (relocatable)
+        {
+            // 先构造新元素，成功后旧元素按字节搬到它两侧，不会再失败
+            const size_type off = pos - begin();
+            try
+            {
+                alloc_traits::construct(data_alloc(), new_begin + off, mystl::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                alloc_traits::deallocate(data_alloc(), new_begin, new_size);
+                throw;
+            }
+            relocate_into(new_begin, new_size, off, 1);
+            return;
+        }
         auto new_end = new_begin;
         try
         {
-            new_end = mystl::uninitialized_move(begin_, pos, new_begin);
-            data_allocator::construct(mystl::address_of(*new_end), mystl::forward<Args>(args)...);
+            new_end = mystl::uninitialized_move(begin(), pos, new_begin);
+            alloc_traits::construct(data_alloc(), mystl::address_of(*new_end), mystl::forward<Args>(args)...);
             ++new_end;
-            new_end = mystl::uninitialized_move(pos, end_, new_end);
+            new_end = mystl::uninitialized_move(pos, end(), new_end);
         }
         catch (...)
         {
-            data_allocator::deallocate(new_begin, new_size);
+            alloc_traits::deallocate(data_alloc(), new_begin, new_size);
             throw;
         }
-        destroy_and_recover(begin_, end_, cap_ - begin_);
+        note_reallocate(size());
+        destroy_and_recover(begin_, end_, capacity_ - begin_);
         begin_ = new_begin;
         end_ = new_end;
         capacity_ = new_begin + new_size;
     }
-    template <class T>
-    void vector<T>::reallocate_insert(iterator pos, const value_type &value)
+    template <class T, class Alloc, class Growth>
+    void vector<T, Alloc, Growth>::reallocate_insert(iterator pos, const value_type &value)
     {
-        const auto new_size = get_new_cap(1);
-        auto new_begin = data_allocator::allocate(new_size);
+        if (can_remap)
+        {
+            const value_type value_copy = value;
+            const size_type n = pos - begin();
+            if (try_remap(get_new_cap(1)))
+            {
+                insert(begin() + n, value_copy);
+                return;
+            }
+        }
+        // 配置器实际给出的空间可能比请求的多，多出的部分也计入容量
+        const auto block = alloc_traits::allocate_at_least(data_alloc(), get_new_cap(1));
+        const auto new_size = block.count;
+        auto new_begin = mystl::to_address(block.ptr);
+        if (relocatable)
+        {
+            const size_type off = pos - begin();
+            try
+            {
+                alloc_traits::construct(data_alloc(), new_begin + off, value);
+            }
+            catch (...)
+            {
+                alloc_traits::deallocate(data_alloc(), new_begin, new_size);
+                throw;
+            }
+            relocate_into(new_begin, new_size, off, 1);
+            return;
+        }
         auto new_end = new_begin;
         const value_type &value_copy = value;
         try
         {
-            new_end = mystl::uninitialized_move(begin_, pos, new_begin);
-            data_allocator::construct(mystl::address_of(*new_end), value_copy);
+            new_end = mystl::uninitialized_move(begin(), pos, new_begin);
+            alloc_traits::construct(data_alloc(), mystl::address_of(*new_end), value_copy);
             ++new_end;
-            new_end = mystl::uninitialized_move(pos, end_, new_end);
+            new_end = mystl::uninitialized_move(pos, end(), new_end);
         }
         catch (...)
         {
-            data_allocator::deallocate(new_begin, new_size);
+            alloc_traits::deallocate(data_alloc(), new_begin, new_size);
             throw;
         }
-        destroy_and_recover(begin_, end_, cap_ - begin_);
+        note_reallocate(size());
+        destroy_and_recover(begin_, end_, capacity_ - begin_);
         begin_ = new_begin;
         end_ = new_end;
         capacity_ = new_begin + new_size;
     }
     /*********************插入：insert****************/
-    template <class T>
-    typename vector<T>::iterator
-    vector<T>::
+    template <class T, class Alloc, class Growth>
+    typename vector<T, Alloc, Growth>::iterator
+    vector<T, Alloc, Growth>::
         fill_insert(iterator pos, size_type n, const value_type &value)
     {
         if (n == 0)
             return pos;
         const size_type xpos = pos - begin_;
         const value_type value_copy = value; // 避免被覆盖
-        if (static_cast<size_type>(cap_ - end_) >= n)
+        if (relocatable && static_cast<size_type>(capacity_ - end_) >= n)
+        { // 元素按字节后移，空位中直接构造
+            open_gap(pos, n);
+            try
+            {
+                mystl::uninitialized_fill_n(pos, n, value_copy);
+            }
+            catch (...)
+            {
+                close_gap(pos, n);
+                throw;
+            }
+        }
+        else if (static_cast<size_type>(capacity_ - end_) >= n)
         { // 如果备用空间大于等于增加的空间
             const size_type after_elems = end_ - pos;
-            auto old_end = end_;
+            auto old_end = end();
             if (after_elems > n)
             {
-                mystl::uninitialized_copy(end_ - n, end_, end_);
+                mystl::uninitialized_copy(end() - n, end(), end());
                 end_ += n;
                 mystl::move_backward(pos, old_end - n, old_end);
                 mystl::uninitialized_fill_n(pos, n, value_copy);
             }
             else
             {
-                end_ = mystl::uninitialized_fill_n(end_, n - after_elems, value_copy);
-                end_ = mystl::uninitialized_move(pos, old_end, end_);
+                end_ = mystl::uninitialized_fill_n(end(), n - after_elems, value_copy);
+                end_ = mystl::uninitialized_move(pos, old_end, end());
                 mystl::uninitialized_fill_n(pos, after_elems, value_copy);
             }
         }
+        else if (try_remap(get_new_cap(n)))
+        { // 配置器直接扩大了区块，空间已经足够
+            return fill_insert(begin() + xpos, n, value_copy);
+        }
         else
         { // 如果备用空间不足
-            const auto new_size = get_new_cap(n);
-            auto new_begin = data_allocator::allocate(new_size);
+            // 配置器实际给出的空间可能比请求的多，多出的部分也计入容量
+            const auto block = alloc_traits::allocate_at_least(data_alloc(), get_new_cap(n));
+            const auto new_size = block.count;
+            auto new_begin = mystl::to_address(block.ptr);
+            if (relocatable)
+            {
+                try
+                {
+                    mystl::uninitialized_fill_n(new_begin + xpos, n, value_copy);
+                }
+                catch (...)
+                {
+                    alloc_traits::deallocate(data_alloc(), new_begin, new_size);
+                    throw;
+                }
+                relocate_into(new_begin, new_size, xpos, n);
+                return begin_ + xpos;
+            }
             auto new_end = new_begin;
             try
             {
-                new_end = mystl::uninitialized_move(begin_, pos, new_begin);
+                new_end = mystl::uninitialized_move(begin(), pos, new_begin);
                 new_end = mystl::uninitialized_fill_n(new_end, n, value);
-                new_end = mystl::uninitialized_move(pos, end_, new_end);
+                new_end = mystl::uninitialized_move(pos, end(), new_end);
             }
             catch (...)
             {
                 destroy_and_recover(new_begin, new_end, new_size);
                 throw;
             }
-            data_allocator::deallocate(begin_, cap_ - begin_);
+            note_reallocate(size());
+            destroy_and_recover(begin_, end_, capacity_ - begin_);
             begin_ = new_begin;
             end_ = new_end;
             capacity_ = begin_ + new_size;
@@ -696,21 +1047,34 @@ namespace mystl
     }
 
     // copy_insert 函数
-    template <class T>
+    template <class T, class Alloc, class Growth>
     template <class IIter>
-    void vector<T>::
+    void vector<T, Alloc, Growth>::
         copy_insert(iterator pos, IIter first, IIter last)
     {
         if (first == last)
             return;
         const auto n = mystl::distance(first, last);
-        if ((cap_ - end_) >= n)
+        if (relocatable && (capacity_ - end_) >= n)
+        { // 元素按字节后移，空位中直接构造
+            open_gap(pos, static_cast<size_type>(n));
+            try
+            {
+                mystl::uninitialized_copy(first, last, pos);
+            }
+            catch (...)
+            {
+                close_gap(pos, static_cast<size_type>(n));
+                throw;
+            }
+        }
+        else if ((capacity_ - end_) >= n)
         { // 如果备用空间大小足够
             const auto after_elems = end_ - pos;
-            auto old_end = end_;
+            auto old_end = end();
             if (after_elems > n)
             {
-                end_ = mystl::uninitialized_copy(end_ - n, end_, end_);
+                end_ = mystl::uninitialized_copy(end() - n, end(), end());
                 mystl::move_backward(pos, old_end - n, old_end);
                 mystl::uninitialized_copy(first, last, pos);
             }
@@ -718,28 +1082,46 @@ namespace mystl
             {
                 auto mid = first;
                 mystl::advance(mid, after_elems);
-                end_ = mystl::uninitialized_copy(mid, last, end_);
-                end_ = mystl::uninitialized_move(pos, old_end, end_);
+                end_ = mystl::uninitialized_copy(mid, last, end());
+                end_ = mystl::uninitialized_move(pos, old_end, end());
                 mystl::uninitialized_copy(first, mid, pos);
             }
         }
         else
         { // 备用空间不足
-            const auto new_size = get_new_cap(n);
-            auto new_begin = data_allocator::allocate(new_size);
+            // 配置器实际给出的空间可能比请求的多，多出的部分也计入容量
+            const auto block = alloc_traits::allocate_at_least(data_alloc(), get_new_cap(n));
+            const auto new_size = block.count;
+            auto new_begin = mystl::to_address(block.ptr);
+            if (relocatable)
+            {
+                const size_type off = pos - begin();
+                try
+                {
+                    mystl::uninitialized_copy(first, last, new_begin + off);
+                }
+                catch (...)
+                {
+                    alloc_traits::deallocate(data_alloc(), new_begin, new_size);
+                    throw;
+                }
+                relocate_into(new_begin, new_size, off, static_cast<size_type>(n));
+                return;
+            }
             auto new_end = new_begin;
             try
             {
-                new_end = mystl::uninitialized_move(begin_, pos, new_begin);
+                new_end = mystl::uninitialized_move(begin(), pos, new_begin);
                 new_end = mystl::uninitialized_copy(first, last, new_end);
-                new_end = mystl::uninitialized_move(pos, end_, new_end);
+                new_end = mystl::uninitialized_move(pos, end(), new_end);
             }
             catch (...)
             {
                 destroy_and_recover(new_begin, new_end, new_size);
                 throw;
             }
-            data_allocator::deallocate(begin_, cap_ - begin_);
+            note_reallocate(size());
+            destroy_and_recover(begin_, end_, capacity_ - begin_);
             begin_ = new_begin;
             end_ = new_end;
             capacity_ = begin_ + new_size;
@@ -747,61 +1129,85 @@ namespace mystl
     }
 
     // reinsert 函数
-    template <class T>
-    void vector<T>::reinsert(size_type size)
+    template <class T, class Alloc, class Growth>
+    void vector<T, Alloc, Growth>::reinsert(size_type size)
     {
-        auto new_begin = data_allocator::allocate(size);
+        if (try_remap(size))
+            return;
+        auto new_begin = mystl::to_address(alloc_traits::allocate(data_alloc(), size));
+        if (relocatable)
+        {
+            relocate_into(new_begin, size, size, 0);
+            return;
+        }
         try
         {
-            mystl::uninitialized_move(begin_, end_, new_begin);
+            mystl::uninitialized_move(begin(), end(), new_begin);
         }
         catch (...)
         {
-            data_allocator::deallocate(new_begin, size);
+            alloc_traits::deallocate(data_alloc(), new_begin, size);
             throw;
         }
-        data_allocator::deallocate(begin_, cap_ - begin_);
+        note_reallocate(size);
+        destroy_and_recover(begin_, end_, capacity_ - begin_);
         begin_ = new_begin;
         end_ = begin_ + size;
         capacity_ = begin_ + size;
     }
     /*****************************运算符重载*******************************/
-    template <class T>
-    bool operator==(const vector<T> &lhs, const vector<T> &rhs)
+    template <class T, class Alloc, class Growth>
+    bool operator==(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
     {
         return lhs.size() == rhs.size() &&
-               mystl::equal(lhs.begin(), lhs.end(), rhs.beign());
+               mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
     }
-    template <class T>
-    bool operator<(const vector<T> &lhs, const vector<T> &rhs)
+    template <class T, class Alloc, class Growth>
+    bool operator<(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
     {
-        return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), lhs.end());
+        return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
     }
-    template <class T>
-    bool operator!=(const vector<T> &lhs, const vector<T> &rhs)
+    template <class T, class Alloc, class Growth>
+    bool operator!=(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
     {
         return !(lhs == rhs);
     }
-    template <class T>
-    bool operator>(const vector<T> &lhs, const vector<T> &rhs)
+    template <class T, class Alloc, class Growth>
+    bool operator>(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
     {
         return rhs < lhs;
     }
-    template <class T>
-    bool operator<=(const vector<T> &lhs, const vector<T> &rhs)
+    template <class T, class Alloc, class Growth>
+    bool operator<=(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
     {
-        return !(lhs < rhs);
+        return !(rhs < lhs);
     }
-    template <class T>
-    bool operator>=(const vector<T> &lhs, const vector<T> &rhs)
+    template <class T, class Alloc, class Growth>
+    bool operator>=(const vector<T, Alloc, Growth> &lhs, const vector<T, Alloc, Growth> &rhs)
     {
         return !(lhs < rhs);
     }
-    template <class T>
-    void swap(vector<T> &lhs, vector<T> &rhs)
+    template <class T, class Alloc, class Growth>
+    void swap(vector<T, Alloc, Growth> &lhs, vector<T, Alloc, Growth> &rhs)
     {
         lhs.swap(rhs);
     }
+
+    // 缓冲区在堆上，vector 本身只有三个指针，配置器、指针和扩容策略都能按字节搬移时 vector 也可以
+    // 使用 offset_ptr 的 vector 不满足
+    template <class T, class Alloc, class Growth>
+    struct is_trivially_relocatable<vector<T, Alloc, Growth>>
+        : std::integral_constant<bool, is_trivially_relocatable<Alloc>::value &&
+                                           is_trivially_relocatable<typename allocator_traits<Alloc>::pointer>::value &&
+                                           is_trivially_relocatable<Growth>::value>
+    {
+    };
+
+    namespace pmr
+    {
+        template <class T>
+        using vector = mystl::vector<T, polymorphic_allocator<T>>;
+    }
 }
 
 #endif
\ No newline at end of file
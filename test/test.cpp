@@ -1,9 +1,13 @@
 #include "test_string.h"
 #include "test_vector.h"
+#include "test_alloc.h"
+#include "test_list.h"
 
 int main()
 {
     //test_string();
     test_vector();
+    test_alloc();
+    test_list();
     return 0;
 }
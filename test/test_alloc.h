@@ -0,0 +1,698 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <vector>
+#include "../mytinystl/base/alloc.h"
+#include "../mytinystl/base/thread_cache_alloc.h"
+#include "../mytinystl/base/remote_free_alloc.h"
+#include "../mytinystl/base/aligned_allocator.h"
+#include "../mytinystl/base/huge_page_allocator.h"
+#include "../mytinystl/base/instrumented_allocator.h"
+#include "../mytinystl/base/shm_allocator.h"
+#include "../mytinystl/base/object_pool.h"
+#include "../mytinystl/base/budget_allocator.h"
+#include "../mytinystl/base/alloc_trace.h"
+#include "../mytinystl/my_vector.h"
+#include "../mytinystl/my_list.h"
+#include "../mytinystl/my_string.h"
+#ifdef MYSTL_HAS_SHM
+#include <sys/wait.h>
+#endif
+#ifdef MYSTL_HAS_MMAP
+#include <sys/resource.h>
+#include <sys/wait.h>
+#endif
+
+// 小对象分配/释放的吞吐量：::operator new 与 pool_alloc 对比
+// 每轮申请 batch 个 16~128 字节的区块，再全部释放
+template <class AllocFunc, class FreeFunc>
+double bench_small_alloc(AllocFunc alloc_func, FreeFunc free_func, size_t rounds, size_t batch)
+{
+    void **ptrs = new void *[batch];
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        for (size_t i = 0; i < batch; ++i)
+            ptrs[i] = alloc_func(16 + (i % 8) * 16);
+        for (size_t i = 0; i < batch; ++i)
+            free_func(ptrs[i], 16 + (i % 8) * 16);
+    }
+    auto end = std::chrono::steady_clock::now();
+    delete[] ptrs;
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(rounds * batch) / seconds / 1e6;
+}
+
+// 多线程 push/pop 压力测试：每个线程反复压入 depth 个区块再全部弹出
+// 返回所有线程合计的吞吐量
+template <class Alloc>
+double bench_thread_push_pop(size_t threads, size_t rounds, size_t depth)
+{
+    auto worker = [rounds, depth]()
+    {
+        std::vector<void *> stack(depth);
+        for (size_t r = 0; r < rounds; ++r)
+        {
+            for (size_t i = 0; i < depth; ++i)
+                stack[i] = Alloc::allocate(16 + (i % 8) * 16);
+            for (size_t i = depth; i > 0; --i)
+                Alloc::deallocate(stack[i - 1], 16 + ((i - 1) % 8) * 16);
+        }
+    };
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (size_t t = 0; t < threads; ++t)
+        pool.emplace_back(worker);
+    for (auto &th : pool)
+        th.join();
+    auto end = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(threads * rounds * depth) / seconds / 1e6;
+}
+
+// 生产者/消费者：一个线程分配并通过单生产者单消费者环形队列发送，另一个线程释放
+// 输出总吞吐量，以及分配与释放各自的 p50 / p99 / p999 延迟
+template <class Alloc>
+void bench_producer_consumer(const char *name, size_t items)
+{
+    const size_t ring_size = 1024;
+    std::vector<std::atomic<void *>> ring(ring_size);
+    std::atomic<size_t> head{0}, tail{0};
+    std::vector<uint32_t> alloc_ns(items), free_ns(items);
+    auto block_size = [](size_t i) { return 16 + (i % 7) * 16; };
+
+    auto start = std::chrono::steady_clock::now();
+    std::thread producer([&]()
+                         {
+        for (size_t i = 0; i < items; ++i)
+        {
+            auto t0 = std::chrono::steady_clock::now();
+            void *p = Alloc::allocate(block_size(i));
+            auto t1 = std::chrono::steady_clock::now();
+            alloc_ns[i] = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+            static_cast<char *>(p)[0] = static_cast<char>(i);
+            while (i - tail.load(std::memory_order_acquire) >= ring_size)
+                std::this_thread::yield();
+            ring[i % ring_size].store(p, std::memory_order_relaxed);
+            head.store(i + 1, std::memory_order_release);
+        } });
+    std::thread consumer([&]()
+                         {
+        for (size_t i = 0; i < items; ++i)
+        {
+            while (head.load(std::memory_order_acquire) <= i)
+                std::this_thread::yield();
+            void *p = ring[i % ring_size].load(std::memory_order_relaxed);
+            tail.store(i + 1, std::memory_order_release);
+            auto t0 = std::chrono::steady_clock::now();
+            Alloc::deallocate(p, block_size(i));
+            auto t1 = std::chrono::steady_clock::now();
+            free_ns[i] = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+        } });
+    producer.join();
+    consumer.join();
+    auto end = std::chrono::steady_clock::now();
+
+    auto percentile = [](std::vector<uint32_t> &v, double q)
+    {
+        auto nth = v.begin() + static_cast<ptrdiff_t>(q * (v.size() - 1));
+        std::nth_element(v.begin(), nth, v.end());
+        return *nth;
+    };
+    std::cout << name << " " << static_cast<double>(items) / std::chrono::duration<double>(end - start).count() / 1e6
+              << " M items/s, alloc p50/p99/p999 " << percentile(alloc_ns, 0.5) << "/"
+              << percentile(alloc_ns, 0.99) << "/" << percentile(alloc_ns, 0.999)
+              << " ns, free p50/p99/p999 " << percentile(free_ns, 0.5) << "/"
+              << percentile(free_ns, 0.99) << "/" << percentile(free_ns, 0.999) << " ns" << std::endl;
+}
+
+// 对齐检查：超出默认对齐的类型与 aligned_allocator 分配的缓冲区
+struct alignas(64) simd_block
+{
+    float lane[16];
+};
+void test_aligned_alloc()
+{
+    mystl::vector<simd_block> blocks(100);
+    mystl::vector<float, mystl::aligned_allocator<float>> floats(1000, 1.0f);
+    mystl::vector<mystl::cache_padded<size_t>,
+                  mystl::aligned_allocator<mystl::cache_padded<size_t>>>
+        slots(8);
+    std::cout << "alignment: simd_block " << reinterpret_cast<uintptr_t>(blocks.data()) % 64
+              << ", aligned_allocator " << reinterpret_cast<uintptr_t>(floats.data()) % 64
+              << ", cache_padded stride " << sizeof(slots[0]) << std::endl;
+}
+
+// 分配统计：定义 MYSTL_ALLOC_TELEMETRY 后输出各类型的统计，否则输出 []
+struct telemetry_tag
+{
+    static constexpr const char *name = "test";
+};
+void test_instrumented_alloc()
+{
+    mystl::vector<int, mystl::instrumented_allocator<int>> v;
+    for (int i = 0; i < 1000; ++i)
+        v.push_back(i);
+    mystl::vector<double, mystl::instrumented_allocator<double, telemetry_tag>> d(100);
+    std::cout << "telemetry: " << mystl::alloc_stats::to_json() << std::endl;
+
+    // 开启统计不改变扩容：allocate_at_least 多给的空间与 reallocate 都要转发
+    mystl::vector<int> plain;
+    for (int i = 0; i < 1000; ++i)
+        plain.push_back(i);
+    typedef mystl::huge_page_allocator<int> huge;
+    std::cout << "telemetry same capacity " << (v.capacity() == plain.capacity())
+              << ", keeps reallocate "
+              << (mystl::has_reallocate<mystl::instrumented_allocator<int, telemetry_tag, huge>>::value ==
+                  mystl::has_reallocate<huge>::value)
+              << std::endl;
+}
+
+// 共享内存：父进程在共享内存中建立 vector、list、string，
+// 子进程先把原来的映射占住，再在另一个地址打开同一段共享内存直接读取
+#ifdef MYSTL_HAS_SHM
+struct shm_root
+{
+    typedef mystl::vector<int, mystl::shm_allocator<int>> vector_type;
+    typedef mystl::list<int, mystl::shm_allocator<int>> list_type;
+    typedef mystl::basic_string<char, mystl::char_traits<char>, mystl::shm_allocator<char>> string_type;
+
+    vector_type v;
+    list_type l;
+    string_type s;
+
+    explicit shm_root(const mystl::shm_segment &seg)
+        : v(mystl::shm_allocator<int>(seg)), l(mystl::shm_allocator<int>(seg)),
+          s(mystl::shm_allocator<char>(seg))
+    {
+    }
+};
+void test_shm_alloc()
+{
+    const char *name = "/mystl_test_shm";
+    mystl::shm_segment seg(name, size_t(1) << 20);
+    shm_root *root = seg.construct_root<shm_root>(seg);
+    // 不清零的 resize 也要能用于 offset_ptr 的容器
+    root->v.resize_default_init(16);
+    root->v.resize_and_overwrite(32, [](int *, size_t) { return size_t(0); });
+    for (int i = 0; i < 1000; ++i)
+    {
+        root->v.push_back(i);
+        root->l.push_back(i);
+    }
+    root->s.resize_and_overwrite(13, [](char *p, size_t n)
+                                 {
+        std::memcpy(p, "shared string", n);
+        return n; });
+    std::cout.flush();
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        ::mmap(seg.base(), seg.size(), PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+        mystl::shm_segment other(name);
+        const shm_root *r = other.root<shm_root>();
+        long vsum = 0, lsum = 0;
+        for (int x : r->v)
+            vsum += x;
+        for (int x : r->l)
+            lsum += x;
+        const bool ok = other.base() != seg.base() && vsum == 499500 && lsum == 499500 &&
+                        r->s.size() == 13;
+        _exit(ok ? 0 : 1);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    std::cout << "shm: child read " << (WIFEXITED(status) && WEXITSTATUS(status) == 0 ? "ok" : "failed")
+              << ", arena used " << seg.arena()->used() << " bytes" << std::endl;
+    seg.destroy_root<shm_root>();
+    mystl::shm_segment::remove(name);
+}
+#endif // MYSTL_HAS_SHM
+
+// 对象池：每个请求需要一个预留了空间的缓冲对象，比较每次 new / delete 与从 object_pool 复用
+struct request_buffer
+{
+    mystl::vector<int> ids;
+    mystl::string text;
+    request_buffer()
+    {
+        ids.reserve(4096);
+        text.append(1024, ' '); // string 没有 reserve，先撑大再清空
+        text.clear();
+    }
+};
+struct clear_request_buffer
+{
+    void operator()(request_buffer &b) const noexcept
+    {
+        b.ids.clear();
+        b.text.clear();
+    }
+};
+template <class Acquire, class Release>
+double bench_request_buffer(size_t rounds, Acquire acquire, Release release)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        request_buffer *b = acquire();
+        for (int i = 0; i < 64; ++i)
+            b->ids.push_back(i);
+        b->text.append(32, 'x');
+        release(b);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / rounds;
+}
+void test_object_pool()
+{
+    const size_t rounds = 200000;
+    double fresh = bench_request_buffer(
+        rounds, []
+        { return new request_buffer; },
+        [](request_buffer *b)
+        { delete b; });
+    mystl::object_pool<request_buffer, clear_request_buffer> pool(16);
+    double pooled = bench_request_buffer(
+        rounds, [&pool]
+        { return pool.acquire(); },
+        [&pool](request_buffer *b)
+        { pool.release(b); });
+    typedef mystl::thread_object_pool<request_buffer, clear_request_buffer> local_pool;
+    double local = bench_request_buffer(
+        rounds, []
+        { return local_pool::acquire(); },
+        [](request_buffer *b)
+        { local_pool::release(b); });
+    std::cout << "request buffer (ns/request): new/delete " << fresh << ", object_pool " << pooled
+              << ", thread_object_pool " << local << ", cached " << pool.cached() << std::endl;
+}
+
+// remote_free_alloc 的 0 字节区块：在另一个线程释放时链接写在头部之后，不能碰到相邻区块的头部
+void test_remote_free_zero_size()
+{
+    const size_t n = 1000;
+    std::vector<void *> blocks(n);
+    for (size_t i = 0; i < n; ++i)
+        blocks[i] = mystl::remote_free_alloc::allocate(i % 2 == 0 ? 0 : 8);
+    std::thread other([&]()
+                      {
+        for (size_t i = 0; i < n; ++i)
+            mystl::remote_free_alloc::deallocate(blocks[i], i % 2 == 0 ? 0 : 8); });
+    other.join();
+    // 再次分配时 owner 取回 remote 队列，区块的头部必须完好
+    for (size_t i = 0; i < n; ++i)
+        blocks[i] = mystl::remote_free_alloc::allocate(i % 2 == 0 ? 0 : 8);
+    for (size_t i = 0; i < n; ++i)
+        mystl::remote_free_alloc::deallocate(blocks[i], i % 2 == 0 ? 0 : 8);
+    std::cout << "remote_free_alloc zero-size blocks freed across threads" << std::endl;
+}
+
+// 临时缓冲区：归并这类算法每次调用都申请一块临时空间，比较 malloc 与 scratch_arena
+void test_scratch_arena()
+{
+    const size_t rounds = 200000;
+    const ptrdiff_t len = 4096;
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        int *p = static_cast<int *>(std::malloc(len * sizeof(int)));
+        p[r % len] = 1;
+        std::free(p);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        auto outer = mystl::get_temporary_buffer<int>(len);
+        auto inner = mystl::get_temporary_buffer<double>(len / 2); // 嵌套申请，按相反顺序释放
+        outer.first[r % len] = 1;
+        inner.first[r % (len / 2)] = 1;
+        mystl::release_temporary_buffer(inner.first);
+        mystl::release_temporary_buffer(outer.first);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    auto ns = [rounds](std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b)
+    { return std::chrono::duration<double, std::nano>(b - a).count() / rounds; };
+    const mystl::scratch_arena &arena = mystl::scratch_arena::local();
+    std::cout << "temporary buffer (ns/call): malloc " << ns(t0, t1) << ", scratch_arena " << ns(t1, t2)
+              << " (two buffers), high water " << arena.high_water() << " bytes, fallbacks "
+              << arena.fallbacks() << std::endl;
+
+    // 不按相反顺序释放：先释放的缓冲区要等后申请的也释放后才收回，不能覆盖仍在使用的空间
+    auto first = mystl::get_temporary_buffer<int>(len);
+    auto second = mystl::get_temporary_buffer<int>(len);
+    std::fill(second.first, second.first + len, 7);
+    mystl::release_temporary_buffer(first.first);
+    auto third = mystl::get_temporary_buffer<int>(len);
+    std::fill(third.first, third.first + third.second, 9);
+    const bool intact = std::count(second.first, second.first + len, 7) == len;
+    mystl::release_temporary_buffer(second.first);
+    mystl::release_temporary_buffer(third.first);
+    // arena 放不下时退回堆上，对齐要求超过 max_align_t 也要满足
+    struct alignas(128) wide
+    {
+        char bytes[128];
+    };
+    auto big = mystl::get_temporary_buffer<wide>(4096);
+    const bool aligned = reinterpret_cast<uintptr_t>(big.first) % alignof(wide) == 0;
+    mystl::release_temporary_buffer(big.first);
+    std::cout << "temporary buffer released out of order intact " << intact << ", over-aligned fallback aligned "
+              << aligned << ", arena used " << arena.used() << std::endl;
+}
+
+// 读回轨迹文件，统计分配与释放的条数；格式不对时返回 -1
+long count_trace_ops(const char *path)
+{
+    std::FILE *f = std::fopen(path, "rb");
+    if (f == nullptr)
+        return -1;
+    char magic[8];
+    long ops = 0;
+    if (std::fread(magic, 1, 8, f) != 8 || std::memcmp(magic, mystl::alloc_trace::magic, 8) != 0)
+        ops = -1;
+    mystl::alloc_trace_record r;
+    while (ops >= 0 && std::fread(&r, sizeof(r), 1, f) == 1)
+    {
+        if (r.op == mystl::alloc_trace_record::define_type)
+            std::fseek(f, (r.size + 7) / 8 * 8, SEEK_CUR);
+        else if (r.op <= mystl::alloc_trace_record::deallocate)
+            ++ops;
+        else
+            ops = -1;
+    }
+    std::fclose(f);
+    return ops;
+}
+
+// 分配轨迹：stop() 时其他线程仍在运行，它们缓冲区中的记录也要写入文件，且不能带到下一次 start()
+void test_alloc_trace()
+{
+    const char *path = "mystl_test.trace";
+    const int threads = 4, per_thread = 5000;
+    const uint16_t type = mystl::alloc_trace::type_id<int>();
+    std::atomic<int> done{0};
+    std::atomic<bool> stopped{false};
+    mystl::alloc_trace::start(path);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&]
+                             {
+            int x = 0;
+            for (int i = 0; i < per_thread; ++i)
+                mystl::alloc_trace::record(i % 2 ? mystl::alloc_trace_record::deallocate
+                                                 : mystl::alloc_trace_record::allocate,
+                                           &x, sizeof(x), type);
+            ++done;
+            while (!stopped.load())
+                std::this_thread::yield();
+            // stop() 之后的记录直接丢弃
+            mystl::alloc_trace::record(mystl::alloc_trace_record::allocate, &x, sizeof(x), type); });
+    }
+    while (done.load() < threads)
+        std::this_thread::yield();
+    mystl::alloc_trace::stop();
+    const long first = count_trace_ops(path);
+    stopped.store(true);
+    for (auto &w : workers)
+        w.join();
+
+    mystl::alloc_trace::start(path);
+    int y = 0;
+    mystl::alloc_trace::record(mystl::alloc_trace_record::allocate, &y, sizeof(y), type);
+    mystl::alloc_trace::stop();
+    const long second = count_trace_ops(path);
+    std::remove(path);
+    std::cout << "alloc_trace: " << first << " of " << threads * per_thread
+              << " ops read back while threads run, next session " << second << " of 1" << std::endl;
+}
+
+// 内存预算：软上限 1MB、硬上限 2MB 且 fail_fast，记录回调次数，并比较记账前后小对象分配的开销
+struct budget_test_tag
+{
+    static constexpr const char *name = "test_budget";
+};
+void count_budget_event(const mystl::memory_budget &, mystl::budget_event event, size_t, void *context)
+{
+    ++static_cast<size_t *>(context)[static_cast<int>(event)];
+}
+void test_budget_alloc()
+{
+    typedef mystl::budget_allocator<int, budget_test_tag> alloc;
+    mystl::memory_budget &budget = alloc::budget();
+    size_t events[3] = {};
+    budget.set_limits(size_t(1) << 20, size_t(2) << 20, true);
+    budget.set_callback(count_budget_event, events);
+    size_t pushed = 0;
+    {
+        mystl::vector<int, alloc> v;
+        try
+        {
+            for (;; ++pushed)
+                v.push_back(static_cast<int>(pushed));
+        }
+        catch (const std::bad_alloc &)
+        {
+        }
+        std::cout << "budget: pushed " << pushed << " ints before bad_alloc, used " << budget.used()
+                  << ", peak " << budget.peak() << ", rejected " << budget.rejected();
+    }
+    std::cout << ", events soft/recovered/hard " << events[0] << '/' << events[1] << '/' << events[2]
+              << ", used after free " << budget.used() << std::endl;
+    // 带大小的构造一次就超过硬上限，也要抛出 bad_alloc
+    bool thrown = false;
+    try
+    {
+        mystl::vector<int, alloc> big(size_t(1) << 20, 7);
+    }
+    catch (const std::bad_alloc &)
+    {
+        thrown = true;
+    }
+    std::cout << "budget: vector(1<<20, 7) over the hard limit throws bad_alloc " << thrown
+              << ", used " << budget.used() << std::endl;
+
+    budget.set_limits(mystl::memory_budget::unlimited, mystl::memory_budget::unlimited);
+    const size_t rounds = 2000, batch = 1000;
+    alloc a;
+    double plain = bench_small_alloc([](size_t n) { return mystl::allocator<int>::allocate(n / sizeof(int)); },
+                                     [](void *p, size_t n) { mystl::allocator<int>::deallocate(static_cast<int *>(p), n / sizeof(int)); },
+                                     rounds, batch);
+    double budgeted = bench_small_alloc([&a](size_t n) { return a.allocate(n / sizeof(int)); },
+                                        [&a](void *p, size_t n) { a.deallocate(static_cast<int *>(p), n / sizeof(int)); },
+                                        rounds, batch);
+    std::cout << "alloc/free 16~128 bytes (M ops/s): allocator " << plain << ", budget_allocator "
+              << budgeted << std::endl;
+}
+
+// 释放方式不同的三种配置器，用于比较大量释放时的开销
+// unsized_delete : 丢掉个数，调用不带大小的 ::operator delete
+// sized_delete   : 调用带大小的 ::operator delete
+// size_class     : 按大小直接归还到 thread_cache_alloc 对应的 free list
+enum class free_policy
+{
+    unsized_delete,
+    sized_delete,
+    size_class
+};
+template <class T, free_policy Policy>
+struct free_policy_allocator
+{
+    typedef T value_type;
+    typedef T *pointer;
+    typedef const T *const_pointer;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    template <class U>
+    struct rebind
+    {
+        typedef free_policy_allocator<U, Policy> other;
+    };
+
+    free_policy_allocator() = default;
+    template <class U>
+    free_policy_allocator(const free_policy_allocator<U, Policy> &) {}
+
+    static T *allocate(size_t n)
+    {
+        if (Policy == free_policy::size_class)
+            return static_cast<T *>(mystl::thread_cache_alloc::allocate(n * sizeof(T)));
+        return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+    static void deallocate(T *ptr, size_t n)
+    {
+        if (Policy == free_policy::unsized_delete)
+            ::operator delete(ptr);
+        else if (Policy == free_policy::sized_delete)
+            ::operator delete(ptr, n * sizeof(T));
+        else
+            mystl::thread_cache_alloc::deallocate(ptr, n * sizeof(T));
+    }
+};
+template <class T, class U, free_policy P>
+bool operator==(const free_policy_allocator<T, P> &, const free_policy_allocator<U, P> &)
+{
+    return true;
+}
+
+// 先建立 count 个 list 和 string，只统计全部析构所用的时间
+template <free_policy Policy>
+void bench_free_heavy(const char *name, size_t count, size_t nodes)
+{
+    typedef mystl::list<int, free_policy_allocator<int, Policy>> list_type;
+    typedef mystl::basic_string<char, mystl::char_traits<char>, free_policy_allocator<char, Policy>>
+        string_type;
+    std::vector<list_type *> lists;
+    std::vector<string_type *> strings;
+    for (size_t i = 0; i < count; ++i)
+    {
+        lists.push_back(new list_type(nodes, static_cast<int>(i)));
+        strings.push_back(new string_type(16 + i % 64, 'x'));
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; ++i)
+    {
+        delete lists[i];
+        delete strings[i];
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::cout << name << std::chrono::duration<double, std::milli>(end - start).count()
+              << " ms" << std::endl;
+}
+
+// 大缓冲区扫描：顺序求和与按伪随机下标读取，比较 4K 页与大页
+template <class Vec>
+void bench_scan(const char *name, size_t n)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    Vec data(n, 1.0f);
+    auto t1 = std::chrono::steady_clock::now();
+    float sum = 0;
+    for (size_t i = 0; i < n; ++i)
+        sum += data[i];
+    auto t2 = std::chrono::steady_clock::now();
+    size_t idx = 0;
+    for (size_t i = 0; i < n / 16; ++i)
+    {
+        idx = (idx * 6364136223846793005ULL + 1442695040888963407ULL) % n;
+        sum += data[idx];
+    }
+    auto t3 = std::chrono::steady_clock::now();
+    auto ms = [](std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b)
+    { return std::chrono::duration<double, std::milli>(b - a).count(); };
+    std::cout << name << " fill " << ms(t0, t1) << " ms, sequential " << ms(t1, t2)
+              << " ms, random " << ms(t2, t3) << " ms (" << sum << ")" << std::endl;
+}
+
+// 大 vector<uint64_t> 逐个追加时的扩容耗时与峰值 RSS
+// allocator<T> 每次扩容都复制全部元素，新旧缓冲区同时存在；
+// huge_page_allocator 用 mremap 移动页表，不复制也不会同时持有两份
+// 在子进程中运行，峰值 RSS 取 ru_maxrss 减去开始时的 RSS
+#ifdef MYSTL_HAS_MMAP
+template <class Vec>
+void bench_huge_growth(const char *name, size_t n)
+{
+    std::cout.flush();
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        const long baseline = usage.ru_maxrss;
+        double grow_ms = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        {
+            Vec v;
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (v.size() == v.capacity())
+                {
+                    auto g0 = std::chrono::steady_clock::now();
+                    v.push_back(i);
+                    grow_ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - g0).count();
+                }
+                else
+                {
+                    v.push_back(i);
+                }
+            }
+            auto t1 = std::chrono::steady_clock::now();
+            v.resize(n / 2);
+            auto s0 = std::chrono::steady_clock::now();
+            v.shrink_to_fit();
+            auto s1 = std::chrono::steady_clock::now();
+            getrusage(RUSAGE_SELF, &usage);
+            std::cout << name << " push_back " << std::chrono::duration<double, std::milli>(t1 - t0).count()
+                      << " ms (growth " << grow_ms << " ms), shrink_to_fit "
+                      << std::chrono::duration<double, std::milli>(s1 - s0).count() << " ms, peak RSS "
+                      << (usage.ru_maxrss - baseline) / 1024 << " MB" << std::endl;
+        }
+        std::cout.flush();
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+}
+#endif // MYSTL_HAS_MMAP
+
+void test_alloc()
+{
+    const size_t rounds = 2000, batch = 1000;
+    double new_ops = bench_small_alloc([](size_t n) { return ::operator new(n); },
+                                       [](void *p, size_t) { ::operator delete(p); },
+                                       rounds, batch);
+    double pool_ops = bench_small_alloc([](size_t n) { return mystl::pool_alloc::allocate(n); },
+                                        [](void *p, size_t n) { mystl::pool_alloc::deallocate(p, n); },
+                                        rounds, batch);
+    std::cout << "alloc/free 16~128 bytes (M ops/s): operator new " << new_ops
+              << ", pool_alloc " << pool_ops << std::endl;
+
+    size_t max_threads = std::thread::hardware_concurrency();
+    if (max_threads == 0)
+        max_threads = 4;
+    for (size_t t = 1; t <= max_threads; t *= 2)
+    {
+        double pool = bench_thread_push_pop<mystl::pool_alloc>(t, 200, 1000);
+        double cached = bench_thread_push_pop<mystl::thread_cache_alloc>(t, 200, 1000);
+        std::cout << "push/pop with " << t << " threads (M ops/s): pool_alloc " << pool
+                  << ", thread_cache_alloc " << cached << std::endl;
+    }
+    std::cout << "producer/consumer, one thread allocates and another frees:" << std::endl;
+    bench_producer_consumer<mystl::pool_alloc>("  pool_alloc        ", 1000000);
+    bench_producer_consumer<mystl::thread_cache_alloc>("  thread_cache_alloc", 1000000);
+    bench_producer_consumer<mystl::remote_free_alloc>("  remote_free_alloc ", 1000000);
+
+    test_aligned_alloc();
+    test_instrumented_alloc();
+    test_object_pool();
+    test_remote_free_zero_size();
+    test_scratch_arena();
+    test_budget_alloc();
+    test_alloc_trace();
+#ifdef MYSTL_HAS_SHM
+    test_shm_alloc();
+#endif
+
+    std::cout << "destroy 10000 lists of 100 nodes and 10000 strings:" << std::endl;
+    bench_free_heavy<free_policy::unsized_delete>("  unsized operator delete ", 10000, 100);
+    bench_free_heavy<free_policy::sized_delete>("  sized operator delete   ", 10000, 100);
+    bench_free_heavy<free_policy::size_class>("  size-class free list    ", 10000, 100);
+
+    const size_t scan_n = size_t(64) << 20; // 256MB 的 float
+    bench_scan<mystl::vector<float>>("scan 4K pages  ", scan_n);
+    bench_scan<mystl::vector<float, mystl::huge_page_allocator<float>>>("scan huge pages", scan_n);
+
+#ifdef MYSTL_HAS_MMAP
+    const size_t grow_n = size_t(128) << 20; // 1GB 的 uint64_t，机器内存足够时可以调大到数 GB
+    bench_huge_growth<mystl::vector<uint64_t>>("grow 1GB allocator         ", grow_n);
+    bench_huge_growth<mystl::vector<uint64_t, mystl::huge_page_allocator<uint64_t>>>(
+        "grow 1GB huge_page (mremap)", grow_n);
+#endif
+}
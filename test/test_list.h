@@ -0,0 +1,100 @@
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include "../mytinystl/my_list.h"
+#include "../mytinystl/my_string.h"
+#include "../mytinystl/base/slab_allocator.h"
+
+// 遍历：建表时每个结点之间穿插一次其他大小的分配，模拟长时间运行后的堆
+// 逐个 operator new 的结点散落在这些分配之间，slab 中的结点是连续的
+template <class List>
+void bench_list_traversal(const char *name, List &list, size_t n)
+{
+    std::vector<mystl::string *> noise;
+    for (size_t i = 0; i < n; ++i)
+    {
+        list.push_back(static_cast<long>(i));
+        noise.push_back(new mystl::string(24 + i % 40, 'x'));
+    }
+    long sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < 10; ++r)
+        for (auto it = list.begin(); it != list.end(); ++it)
+            sum += *it;
+    auto end = std::chrono::steady_clock::now();
+    for (auto p : noise)
+        delete p;
+    std::cout << name << " traversal " << std::chrono::duration<double, std::milli>(end - start).count()
+              << " ms (" << sum << ")" << std::endl;
+}
+
+// 插入删除：在表头删除、在表尾插入，结点反复回收再利用
+template <class List>
+void bench_list_insert_erase(const char *name, List &list, size_t n, size_t rounds)
+{
+    for (size_t i = 0; i < n; ++i)
+        list.push_back(static_cast<long>(i));
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        list.pop_front();
+        list.push_back(static_cast<long>(r));
+        list.insert(list.begin(), static_cast<long>(r));
+        list.erase(list.begin());
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::cout << name << " insert/erase "
+              << static_cast<double>(rounds * 4) / std::chrono::duration<double>(end - start).count() / 1e6
+              << " M ops/s" << std::endl;
+}
+
+// 移动之后的 list 是可以继续使用的空 list
+template <class List>
+void test_moved_from_list(const char *name, List a, List c)
+{
+    a.push_back(1);
+    a.push_back(2);
+    List b(mystl::move(a));
+    const bool ctor_ok = a.empty() && a.begin() == a.end() && b.size() == 2;
+    a.push_back(3);
+    c = mystl::move(a);
+    const bool assign_ok = a.empty() && a.size() == 0 && c.size() == 1 && c.front() == 3;
+    a.assign(b.begin(), b.end());
+    a = b;
+    a.push_back(5);
+    std::cout << name << " moved-from list reusable: " << (ctor_ok && assign_ok && a.size() == 3 && a.back() == 5)
+              << std::endl;
+}
+
+void test_list()
+{
+    test_moved_from_list("list<long>           ", mystl::list<long>(), mystl::list<long>());
+    {
+        mystl::slab_pool pool;
+        typedef mystl::list<long, mystl::slab_allocator<long>> slab_list;
+        test_moved_from_list("list<long, slab_pool>", slab_list(&pool), slab_list(&pool));
+    }
+    const size_t n = 1000000;
+    {
+        mystl::list<long> plain;
+        bench_list_traversal("operator new", plain, n);
+    }
+    {
+        mystl::slab_pool pool;
+        mystl::list<long, mystl::slab_allocator<long>> slab(&pool);
+        bench_list_traversal("slab_pool   ", slab, n);
+    }
+    {
+        mystl::list<long> plain;
+        bench_list_insert_erase("operator new", plain, 1000, 2000000);
+    }
+    {
+        // 两个 list 共享同一个 slab_pool
+        mystl::slab_pool pool;
+        mystl::list<long, mystl::slab_allocator<long>> a(&pool), b(&pool);
+        bench_list_insert_erase("slab_pool   ", a, 1000, 2000000);
+        b.splice(b.end(), a);
+        std::cout << "shared slab_pool: " << b.size() << " nodes in " << pool.slab_count()
+                  << " slabs" << std::endl;
+    }
+}
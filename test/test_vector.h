@@ -1,5 +1,507 @@
+#include <algorithm>
 #include <vector>
+#include <chrono>
+#include <cstring>
 #include <iostream>
+#include "../mytinystl/my_vector.h"
+#include "../mytinystl/my_small_vector.h"
+#include "../mytinystl/my_static_vector.h"
+#include "../mytinystl/my_list.h"
+#include "../mytinystl/my_string.h"
+#include "../mytinystl/my_bit_vector.h"
+#include "../mytinystl/my_soa_vector.h"
+#include "../mytinystl/my_stable_vector.h"
+
+// 无状态的配置器利用空基类优化，不增加容器的大小
+static_assert(sizeof(mystl::vector<int>) == 3 * sizeof(void *), "vector<int> size changed");
+static_assert(sizeof(mystl::list<int>) == 2 * sizeof(void *), "list<int> size changed");
+static_assert(sizeof(mystl::string) == 3 * sizeof(void *), "string size changed");
+// 统计重新分配时才多出两个计数器
+static_assert(sizeof(mystl::vector<int, mystl::allocator<int>, mystl::growth_stats<mystl::growth_2x>>) ==
+                  3 * sizeof(void *) + 2 * sizeof(size_t),
+              "growth_stats adds two counters");
+// static_vector 没有指针，元素可以按字节复制时整个对象也可以
+static_assert(std::is_trivially_copyable<mystl::static_vector<int, 8>>::value,
+              "static_vector<int> should be trivially copyable");
+static_assert(!std::is_trivially_copyable<mystl::static_vector<mystl::string, 8>>::value,
+              "static_vector<string> must copy its elements");
+
+// 带状态且会传播的配置器，用来检查容器是否遵守 propagate_on_container_*
+template <class T>
+struct tagged_allocator
+{
+    typedef T value_type;
+    typedef T *pointer;
+    typedef const T *const_pointer;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef std::true_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    template <class U>
+    struct rebind
+    {
+        typedef tagged_allocator<U> other;
+    };
+
+    int tag;
+
+    tagged_allocator(int t = 0) noexcept : tag(t) {}
+    template <class U>
+    tagged_allocator(const tagged_allocator<U> &other) noexcept : tag(other.tag) {}
+
+    T *allocate(size_t n) { return static_cast<T *>(::operator new(n * sizeof(T))); }
+    void deallocate(T *ptr, size_t) { ::operator delete(ptr); }
+};
+template <class T, class U>
+bool operator==(const tagged_allocator<T> &lhs, const tagged_allocator<U> &rhs) noexcept
+{
+    return lhs.tag == rhs.tag;
+}
+
+void test_allocator_propagation()
+{
+    typedef tagged_allocator<int> alloc;
+    mystl::vector<int, alloc> a(3, 1, alloc(1)), b(5, 2, alloc(2));
+    a = b;
+    std::cout << "copy  : tag " << a.get_allocator().tag << ", size " << a.size() << std::endl;
+    mystl::vector<int, alloc> c(2, 3, alloc(3));
+    a = mystl::move(c);
+    std::cout << "move  : tag " << a.get_allocator().tag << ", size " << a.size() << std::endl;
+    a.swap(b);
+    std::cout << "swap  : tag " << a.get_allocator().tag << ", size " << a.size() << std::endl;
+
+    mystl::list<int, alloc> la(3, 1, alloc(1)), lb(5, 2, alloc(2));
+    la = lb;
+    std::cout << "list  : tag " << la.get_allocator().tag << ", size " << la.size() << std::endl;
+    mystl::basic_string<char, mystl::char_traits<char>, tagged_allocator<char>>
+        sa("abc", tagged_allocator<char>(1)), sb("defgh", tagged_allocator<char>(2));
+    sa = mystl::move(sb);
+    std::cout << "string: tag " << sa.get_allocator().tag << ", size " << sa.size() << std::endl;
+}
+
+// 容器复制、移动、交换的耗时，比较无状态的 allocator 与 pmr::polymorphic_allocator
+template <class Vec>
+void bench_copy_move_swap(const char *name, size_t rounds, size_t n)
+{
+    Vec src(n, 1);
+    Vec dst;
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+        dst = src;
+    auto t1 = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        Vec tmp(mystl::move(src));
+        src = mystl::move(tmp);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+        src.swap(dst);
+    auto t3 = std::chrono::steady_clock::now();
+    auto ns = [rounds](std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b)
+    { return std::chrono::duration<double, std::nano>(b - a).count() / rounds; };
+    std::cout << name << " copy " << ns(t0, t1) << " ns, move " << ns(t1, t2)
+              << " ns, swap " << ns(t2, t3) << " ns" << std::endl;
+}
+
+// 追加元素时的重新分配次数：allocator 通过 allocate_at_least 用上内存池或 malloc 多给的空间，
+// pmr::polymorphic_allocator 只按请求的大小计算容量
+template <class Container, class Value>
+void bench_append_reallocs(const char *name, size_t n, Value value)
+{
+    Container c;
+    size_t reallocs = 0;
+    auto cap = c.capacity();
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < n; ++i)
+    {
+        c.push_back(value);
+        if (c.capacity() != cap)
+        {
+            ++reallocs;
+            cap = c.capacity();
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    std::cout << name << " reallocs " << reallocs << ", capacity " << cap << ", "
+              << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms" << std::endl;
+}
+
+// small_vector 在内部缓冲区与堆之间切换：溢出、收缩、各种组合的移动与交换
+void test_small_vector()
+{
+    typedef mystl::small_vector<mystl::string, 4> svec;
+    svec a;
+    for (int i = 0; i < 4; ++i)
+        a.push_back(mystl::string(8, static_cast<char>('a' + i)));
+    std::cout << "small_vector inline " << a.is_inline() << ", capacity " << a.capacity();
+    a.push_back(mystl::string(8, 'e'));
+    std::cout << ", after spill inline " << a.is_inline() << ", size " << a.size();
+    a.erase(a.begin() + 1, a.end() - 1);
+    a.shrink_to_fit();
+    std::cout << ", after shrink inline " << a.is_inline() << ", " << a.front().c_str()
+              << ' ' << a.back().c_str() << std::endl;
+
+    svec heap(10, mystl::string(3, 'h'));
+    svec moved(mystl::move(heap));   // 堆上的缓冲区直接接管
+    svec small{mystl::string(3, 's')};
+    svec copied(small);
+    moved.swap(copied);              // 一边在内部缓冲区
+    small = mystl::move(copied);     // 内部缓冲区中的元素逐个移动
+    copied = {mystl::string(1, 'x'), mystl::string(1, 'y')};
+    std::cout << "small_vector moved " << moved.size() << moved.is_inline()
+              << ", small " << small.size() << small.is_inline()
+              << ", copied " << copied.size() << copied.is_inline()
+              << ", heap " << heap.size() << heap.is_inline() << std::endl;
+}
+
+// 记录当前未释放字节数的内存资源，检查空间是否由分配它的资源释放
+class live_bytes_resource : public mystl::pmr::memory_resource
+{
+public:
+    long live = 0;
+
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        live += static_cast<long>(bytes);
+        return mystl::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void *ptr, size_t bytes, size_t alignment) override
+    {
+        live -= static_cast<long>(bytes);
+        mystl::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+    bool do_is_equal(const mystl::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+// 两个不同资源的 small_vector 在堆上时移动赋值、交换：不能接管对方的缓冲区
+void test_small_vector_pmr()
+{
+    typedef mystl::small_vector<int, 2, mystl::pmr::polymorphic_allocator<int>> svec;
+    live_bytes_resource ra, rb;
+    {
+        svec a{&ra}, b{&rb}, c{&ra};
+        for (int i = 0; i < 10; ++i)
+        {
+            a.push_back(i);
+            b.push_back(i * 2);
+            c.push_back(i * 3);
+        }
+        a = mystl::move(b);
+        const long a_after_move = ra.live, b_after_move = rb.live;
+        a.swap(c);
+        std::cout << "small_vector pmr move-assign a " << a.size() << " (back " << c.back()
+                  << "), live A/B after move " << a_after_move << '/' << b_after_move;
+    }
+    std::cout << ", after destruction " << ra.live << '/' << rb.live << std::endl;
+}
+
+// 不同扩容策略追加 n 个元素：重新分配次数、搬移的字节数与最终容量
+template <class Growth>
+void bench_growth_policy(const char *name, size_t n)
+{
+    mystl::vector<int, mystl::allocator<int>, mystl::growth_stats<Growth>> v;
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < n; ++i)
+        v.push_back(static_cast<int>(i));
+    auto t1 = std::chrono::steady_clock::now();
+    const auto &stats = v.get_growth_policy();
+    std::cout << name << " reallocs " << stats.reallocations() << ", moved "
+              << stats.bytes_moved() / 1024 << " KB, capacity " << v.capacity() << ", "
+              << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms" << std::endl;
+}
+
+// 与 mystl::string 相同，但没有声明 is_trivially_relocatable，扩容、插入、删除时逐个移动元素
+struct plain_string : mystl::string
+{
+    using mystl::string::basic_string;
+};
+
+// vector<string> 整体搬到新区块（reserve / shrink_to_fit）以及在头部反复插入、删除的耗时：
+// 按字节搬移与逐个移动构造再析构的对比
+template <class String>
+void bench_relocate(const char *name, size_t n, size_t rounds, size_t front_ops)
+{
+    mystl::vector<String> v;
+    for (size_t i = 0; i < n; ++i)
+        v.push_back(String("relocate me please"));
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        v.reserve(v.capacity() + 1);
+        v.shrink_to_fit();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < front_ops; ++i)
+    {
+        v.insert(v.begin(), String("x"));
+        v.erase(v.begin());
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    std::cout << name << " regrow " << std::chrono::duration<double, std::milli>(t1 - t0).count() / (2 * rounds)
+              << " ms, front insert/erase " << std::chrono::duration<double, std::micro>(t2 - t1).count() / front_ops
+              << " us" << std::endl;
+}
+
+// static_vector 的插入删除与溢出：Checked 版本抛出 length_error 且元素不变
+void test_static_vector()
+{
+    mystl::static_vector<mystl::string, 4> a{mystl::string("a"), mystl::string("d")};
+    mystl::string mid[] = {mystl::string("b"), mystl::string("c")};
+    a.insert(a.begin() + 1, mid, mid + 2);
+    bool overflow = false;
+    try
+    {
+        a.push_back(mystl::string("e"));
+    }
+    catch (const std::length_error &)
+    {
+        overflow = true;
+    }
+    mystl::static_vector<mystl::string, 4> b(1, mystl::string("z"));
+    b.swap(a);
+    b.erase(b.begin() + 1);
+    std::cout << "static_vector overflow " << overflow << ", size " << a.size() << " " << b.size() << ": "
+              << a.front().c_str() << ' ';
+    for (auto &s : b)
+        std::cout << s.c_str();
+    std::cout << std::endl;
+
+    // 可以按字节复制的 static_vector 作为元素时，copy 走 memmove
+    mystl::static_vector<int, 4> rows[2];
+    rows[0] = {1, 2, 3};
+    mystl::copy(rows, rows + 1, rows + 1);
+    std::cout << "static_vector rows copied " << (rows[0] == rows[1]) << std::endl;
+}
+
+// 构造、填充、析构 n 个元素的耗时：n 不超过 N 时 small_vector 不访问堆
+template <class Vec>
+double bench_churn(size_t rounds, int n)
+{
+    long long sum = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        Vec v;
+        for (int i = 0; i < n; ++i)
+            v.push_back(i);
+        sum += static_cast<long long>(v.size());
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    if (sum < 0)
+        std::cout << sum;
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / rounds;
+}
+
+void bench_small_vector_churn(size_t rounds)
+{
+    std::cout << "churn ns     n: vector<int> / small_vector<int,8> / small_vector<int,16>" << std::endl;
+    for (int n = 0; n <= 16; n += 2)
+    {
+        std::cout << "churn ns " << (n < 10 ? "    " : "   ") << n << ": "
+                  << bench_churn<mystl::vector<int>>(rounds, n) << " / "
+                  << bench_churn<mystl::small_vector<int, 8>>(rounds, n) << " / "
+                  << bench_churn<mystl::small_vector<int, 16>>(rounds, n) << std::endl;
+    }
+}
+
+// I/O 缓冲区：resize 后再 read 会先把整块清零，resize_and_overwrite 只写一遍
+// fake_read 模拟 read()，写入 min(n, len) 个字节并返回写入的个数
+struct fake_read
+{
+    const char *src;
+    size_t len;
+    size_t operator()(char *buf, size_t n) const
+    {
+        const size_t got = n < len ? n : len;
+        std::memcpy(buf, src, got);
+        return got;
+    }
+};
+
+template <class Buffer>
+void bench_io_buffer(const char *name, size_t bytes, size_t rounds)
+{
+    mystl::vector<char> src(bytes, 'r');
+    const fake_read rd{src.data(), bytes - 1};
+    Buffer buf;
+    buf.resize(bytes); // 先把缓冲区分配好，两种写法都不再包含分配的时间
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        buf.clear();
+        buf.resize(bytes);
+        buf.resize(rd(&*buf.begin(), bytes));
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        buf.clear();
+        buf.resize_and_overwrite(bytes, rd);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    std::cout << name << " resize+read " << std::chrono::duration<double, std::milli>(t1 - t0).count() / rounds
+              << " ms, resize_and_overwrite " << std::chrono::duration<double, std::milli>(t2 - t1).count() / rounds
+              << " ms, size " << buf.size() << std::endl;
+}
+
+// 过滤掩码：两个谓词的结果按位与、去掉第三个，数出选中的行数，再遍历选中的行
+// vector<char> 每行一个字节，是 bit_vector 出现之前的做法
+inline double elapsed_ms(std::chrono::steady_clock::time_point from)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - from).count();
+}
+
+void bench_bit_vector(size_t n, size_t rounds)
+{
+    mystl::bit_vector<> a(n), b(n), c(n);
+    mystl::vector<char> ca(n), cb(n), cc(n);
+    uint64_t x = 88172645463325252ULL;
+    for (size_t i = 0; i < n; ++i)
+    {
+        x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+        const bool pa = (x & 3) != 0, pb = (x & 12) != 0, pc = (x & 0x3f0) == 0;
+        a[i] = pa, b[i] = pb, c[i] = pc;
+        ca[i] = pa, cb[i] = pb, cc[i] = pc;
+    }
+    size_t bits_count = 0, bytes_count = 0, bits_sum = 0, each_sum = 0, bytes_sum = 0;
+    double bits_mask = 0, bits_scan = 0, bits_each = 0, bytes_mask = 0, bytes_scan = 0;
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        mystl::bit_vector<> m(a);
+        m &= b;
+        m.and_not(c);
+        bits_count += m.count();
+        bits_mask += elapsed_ms(t0);
+        t0 = std::chrono::steady_clock::now();
+        for (auto i = m.find_first(); i != m.npos; i = m.find_next(i))
+            bits_sum += i;
+        bits_scan += elapsed_ms(t0);
+        t0 = std::chrono::steady_clock::now();
+        m.for_each_set([&](size_t i) { each_sum += i; });
+        bits_each += elapsed_ms(t0);
+    }
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        mystl::vector<char> m(ca);
+        for (size_t i = 0; i < n; ++i)
+            m[i] = m[i] & cb[i] & !cc[i];
+        for (size_t i = 0; i < n; ++i)
+            bytes_count += m[i];
+        bytes_mask += elapsed_ms(t0);
+        t0 = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (m[i])
+                bytes_sum += i;
+        }
+        bytes_scan += elapsed_ms(t0);
+    }
+    std::cout << "bit_vector " << n / 1000000 << "M bits, " << a.num_words() * 8 / 1024 << " KB: mask+count "
+              << bits_mask / rounds << " ms, find_next " << bits_scan / rounds
+              << " ms, for_each_set " << bits_each / rounds << " ms; vector<char> " << n / 1024
+              << " KB: mask+count " << bytes_mask / rounds << " ms, scan " << bytes_scan / rounds
+              << " ms; same result "
+              << (bits_count == bytes_count && bits_sum == bytes_sum && each_sum == bytes_sum) << std::endl;
+}
+
+// 宽记录只扫描两个字段：vector<Record> 每行读入 64 字节，soa_vector 只读这两列的 12 字节
+struct trade_record
+{
+    int64_t id;
+    int64_t timestamp;
+    double price;
+    int32_t quantity;
+    int32_t venue;
+    char symbol[32];
+};
+
+void bench_soa_vector(size_t n, size_t rounds)
+{
+    mystl::vector<trade_record> aos;
+    mystl::soa_vector<int64_t, int64_t, double, int32_t, int32_t, mystl::static_vector<char, 32>> soa;
+    for (size_t i = 0; i < n; ++i)
+    {
+        const int64_t id = static_cast<int64_t>(i);
+        const double price = static_cast<double>(i % 1000) * 0.25;
+        const int32_t quantity = static_cast<int32_t>(i % 97);
+        aos.push_back(trade_record{id, id * 1000, price, quantity, 1, "SYM"});
+        soa.push_back(std::make_tuple(id, id * 1000, price, quantity, 1, mystl::static_vector<char, 32>(3, 'S')));
+    }
+    double aos_sum = 0, soa_sum = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        for (const auto &rec : aos)
+            aos_sum += rec.price * rec.quantity;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        const auto price = soa.column<2>();
+        const auto quantity = soa.column<3>();
+        for (size_t i = 0; i < price.size(); ++i)
+            soa_sum += price[i] * quantity[i];
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    std::cout << "scan price*quantity over " << n / 1000000 << "M rows: vector<Record> "
+              << std::chrono::duration<double, std::milli>(t1 - t0).count() / rounds << " ms, soa_vector "
+              << std::chrono::duration<double, std::milli>(t2 - t1).count() / rounds << " ms, same result "
+              << (aos_sum == soa_sum) << std::endl;
+
+    // 容量已满时实参引用容器内的元素：先构造新行再搬移旧元素
+    mystl::soa_vector<mystl::string, int> names;
+    names.emplace_back(mystl::string(40, 'n'), 1);
+    for (int i = 0; i < 8; ++i)
+    {
+        names.shrink_to_fit();
+        names.emplace_back(names.column<0>()[0], std::get<1>(names[0]));
+    }
+    std::cout << "soa_vector emplace_back of own element: " << names.size() << " rows, "
+              << names.column<0>().back().size() << " chars" << std::endl;
+}
+
+// 每次 push_back 的延迟：vector 扩容时要把整个缓冲区搬到新区块，stable_vector 只分配下一段
+// 扩容只发生几十次，p99 / p999 看不到，最慢的一次才反映出搬移的代价
+struct ingest_record
+{
+    int64_t fields[4];
+};
+
+template <class Vec>
+void bench_push_back_latency(const char *name, size_t n)
+{
+    std::vector<uint32_t> ns(n);
+    Vec v;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < n; ++i)
+    {
+        const int64_t x = static_cast<int64_t>(i);
+        auto t0 = std::chrono::steady_clock::now();
+        v.push_back(ingest_record{{x, x, x, x}});
+        auto t1 = std::chrono::steady_clock::now();
+        ns[i] = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    auto percentile = [](std::vector<uint32_t> &lat, double q)
+    {
+        auto nth = lat.begin() + static_cast<ptrdiff_t>(q * (lat.size() - 1));
+        std::nth_element(lat.begin(), nth, lat.end());
+        return *nth;
+    };
+    std::cout << name << " total " << std::chrono::duration<double, std::milli>(end - start).count()
+              << " ms, push_back p50/p99/p999/max " << percentile(ns, 0.5) << "/" << percentile(ns, 0.99) << "/"
+              << percentile(ns, 0.999) << "/" << *std::max_element(ns.begin(), ns.end()) << " ns" << std::endl;
+}
 
 void test_vector()
 {
@@ -8,4 +510,28 @@ void test_vector()
     for (auto item : a)
         std::cout << item << ' ';
     std::cout << std::endl;
-}
\ No newline at end of file
+
+    test_allocator_propagation();
+    bench_copy_move_swap<mystl::vector<int>>("vector<int>      ", 100000, 64);
+    bench_copy_move_swap<mystl::pmr::vector<int>>("pmr::vector<int> ", 100000, 64);
+    bench_append_reallocs<mystl::vector<int>>("append vector<int>     ", 1000000, 1);
+    bench_append_reallocs<mystl::pmr::vector<int>>("append pmr::vector<int>", 1000000, 1);
+    bench_append_reallocs<mystl::string>("append string          ", 1000000, 'x');
+    bench_append_reallocs<mystl::pmr::string>("append pmr::string     ", 1000000, 'x');
+    bench_growth_policy<mystl::growth_1_5x>("growth 1.5x          ", 1000000);
+    bench_growth_policy<mystl::growth_2x>("growth 2x            ", 1000000);
+    bench_growth_policy<mystl::fixed_step_growth<65536>>("growth step 64K      ", 1000000);
+    bench_growth_policy<mystl::capped_geometric_growth<65536>>("growth 2x capped 64K ", 1000000);
+    bench_relocate<mystl::string>("relocate 1M vector<string>      ", 1000000, 10, 200);
+    bench_relocate<plain_string>("relocate 1M vector<plain_string>", 1000000, 10, 200);
+    bench_io_buffer<mystl::vector<char>>("io 64MB vector<char>", 64 << 20, 10);
+    bench_io_buffer<mystl::string>("io 64MB string      ", 64 << 20, 10);
+    bench_bit_vector(100000000, 3);
+    bench_soa_vector(4000000, 10);
+    bench_push_back_latency<mystl::vector<ingest_record>>("ingest 4M vector       ", 4000000);
+    bench_push_back_latency<mystl::stable_vector<ingest_record>>("ingest 4M stable_vector", 4000000);
+    test_small_vector();
+    test_small_vector_pmr();
+    test_static_vector();
+    bench_small_vector_churn(1000000);
+}
@@ -0,0 +1,303 @@
+// alloc_replay：回放 alloc_trace 记录的分配轨迹，比较不同配置器的表现
+//
+// 记录：用 -DMYSTL_ALLOC_TRACE 编译程序，在程序中调用 mystl::alloc_trace::start / stop
+// 编译：g++ -std=c++17 -O2 -pthread -I.. alloc_replay.cpp -o alloc_replay
+// 用法：alloc_replay <trace 文件> [配置器 ...]
+//       配置器可选 malloc、new、pool、thread_cache、remote_free、monotonic，默认全部
+//
+// 轨迹按时间戳排序后在单个线程中回放，每个配置器在单独的子进程中运行，互不影响 RSS
+// 分配与释放的配对在父进程中预先算好，子进程回放时只用一个提前分配并写过的指针数组，
+// 记账本身不再从被测的堆上分配；父进程在 fork 之前把空闲的堆内存还给系统（glibc 的 malloc_trim）
+// 输出：吞吐量、峰值 RSS（子进程 getrusage 的 ru_maxrss 相对回放前的增量）、峰值时实际请求的字节数，
+//       以及碎片率 = 1 - 峰值请求字节数 / 峰值 RSS 增量；
+//       被测配置器复用回放前已常驻的页面时增量可能小于请求字节数，此时碎片率记为 0
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <cxxabi.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "../mytinystl/base/alloc_trace.h"
+#include "../mytinystl/base/alloc.h"
+#include "../mytinystl/base/thread_cache_alloc.h"
+#include "../mytinystl/base/remote_free_alloc.h"
+#include "../mytinystl/base/memory_resource.h"
+
+namespace
+{
+    typedef mystl::alloc_trace_record record;
+
+    struct trace
+    {
+        std::vector<record> ops;        // 按时间戳排序的分配与释放
+        std::vector<std::string> types; // 下标为类型编号
+        std::vector<uint32_t> slots;    // 每条记录在指针数组中的下标，no_slot 表示跳过
+        size_t slot_count = 0;          // 指针数组的大小，即同时存活的区块数的峰值
+    };
+    constexpr uint32_t no_slot = UINT32_MAX;
+
+    // 为分配与释放配对：每个存活的区块占用一个下标，释放后下标回收
+    // 开始记录之前分配的区块没有对应的分配记录，它们的释放标记为跳过
+    void assign_slots(trace &t)
+    {
+        std::unordered_map<uint64_t, uint32_t> live;
+        std::vector<uint32_t> free_slots;
+        t.slots.resize(t.ops.size());
+        for (size_t i = 0; i < t.ops.size(); ++i)
+        {
+            const record &r = t.ops[i];
+            if (r.op == record::allocate)
+            {
+                uint32_t slot;
+                if (free_slots.empty())
+                {
+                    slot = static_cast<uint32_t>(t.slot_count++);
+                }
+                else
+                {
+                    slot = free_slots.back();
+                    free_slots.pop_back();
+                }
+                live[r.address] = slot;
+                t.slots[i] = slot;
+            }
+            else
+            {
+                auto it = live.find(r.address);
+                if (it == live.end())
+                {
+                    t.slots[i] = no_slot;
+                    continue;
+                }
+                t.slots[i] = it->second;
+                free_slots.push_back(it->second);
+                live.erase(it);
+            }
+        }
+    }
+
+    bool load_trace(const char *path, trace &t)
+    {
+        std::FILE *f = std::fopen(path, "rb");
+        if (f == nullptr)
+            return false;
+        char magic[8];
+        if (std::fread(magic, 1, 8, f) != 8 || std::memcmp(magic, mystl::alloc_trace::magic, 8) != 0)
+        {
+            std::fclose(f);
+            return false;
+        }
+        record r;
+        while (std::fread(&r, sizeof(r), 1, f) == 1)
+        {
+            if (r.op == record::define_type)
+            {
+                std::string name((r.size + 7) / 8 * 8, '\0');
+                if (std::fread(&name[0], 1, name.size(), f) != name.size())
+                    break;
+                name.resize(r.size);
+                int status = 0;
+                char *demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+                if (demangled != nullptr)
+                {
+                    name = demangled;
+                    std::free(demangled);
+                }
+                if (t.types.size() <= r.type)
+                    t.types.resize(r.type + 1);
+                t.types[r.type] = name;
+            }
+            else
+            {
+                t.ops.push_back(r);
+            }
+        }
+        std::fclose(f);
+        std::stable_sort(t.ops.begin(), t.ops.end(), [](const record &a, const record &b)
+                         { return a.timestamp < b.timestamp; });
+        assign_slots(t);
+        return true;
+    }
+
+    // 当前进程的常驻内存（字节）
+    size_t current_rss()
+    {
+        std::FILE *f = std::fopen("/proc/self/statm", "r");
+        if (f == nullptr)
+            return 0;
+        unsigned long size = 0, resident = 0;
+        if (std::fscanf(f, "%lu %lu", &size, &resident) != 2)
+            resident = 0;
+        std::fclose(f);
+        return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+    // 当前进程常驻内存的峰值（字节），fork 出的子进程从 fork 时的常驻内存开始计
+    size_t peak_rss()
+    {
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+        return static_cast<size_t>(usage.ru_maxrss) * 1024;
+    }
+
+    // 候选配置器：统一成 allocate(bytes) / deallocate(ptr, bytes)
+    struct malloc_candidate
+    {
+        void *allocate(size_t n) { return std::malloc(n == 0 ? 1 : n); }
+        void deallocate(void *p, size_t) { std::free(p); }
+    };
+    struct new_candidate
+    {
+        void *allocate(size_t n) { return ::operator new(n); }
+        void deallocate(void *p, size_t n) { ::operator delete(p, n); }
+    };
+    template <class Alloc>
+    struct static_candidate
+    {
+        void *allocate(size_t n) { return Alloc::allocate(n); }
+        void deallocate(void *p, size_t n) { Alloc::deallocate(p, n); }
+    };
+    struct monotonic_candidate
+    {
+        mystl::pmr::monotonic_buffer_resource resource;
+        void *allocate(size_t n) { return resource.allocate(n); }
+        void deallocate(void *p, size_t n) { resource.deallocate(p, n); }
+    };
+
+    template <class Candidate>
+    void replay(const char *name, const trace &t)
+    {
+        Candidate candidate;
+        // 记账用的指针数组在测量基线之前分配好，值初始化时每一页都已写过
+        std::vector<void *> live(t.slot_count);
+        const size_t baseline = current_rss();
+        size_t live_bytes = 0, peak_live = 0;
+        size_t replayed = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < t.ops.size(); ++i)
+        {
+            const record &r = t.ops[i];
+            const uint32_t slot = t.slots[i];
+            if (slot == no_slot)
+                continue;
+            if (r.op == record::allocate)
+            {
+                void *p = candidate.allocate(r.size);
+                std::memset(p, 0, r.size); // 像真实程序一样写入，使页面真正被占用
+                live[slot] = p;
+                live_bytes += r.size;
+                peak_live = std::max(peak_live, live_bytes);
+            }
+            else
+            {
+                candidate.deallocate(live[slot], r.size);
+                live_bytes -= r.size;
+            }
+            ++replayed;
+        }
+        auto end = std::chrono::steady_clock::now();
+        const size_t peak = std::max(peak_rss(), current_rss());
+
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        const size_t rss_delta = peak > baseline ? peak - baseline : 0;
+        const double fragmentation =
+            rss_delta <= peak_live ? 0.0 : 1.0 - static_cast<double>(peak_live) / rss_delta;
+        std::printf("%-12s %10.2f M ops/s  peak RSS %10.2f MB  peak live %10.2f MB  fragmentation %6.1f%%\n",
+                    name, replayed / seconds / 1e6, rss_delta / 1048576.0, peak_live / 1048576.0,
+                    fragmentation * 100);
+    }
+
+    // 在子进程中回放，避免前一个配置器留下的内存影响后一个的 RSS
+    template <class Candidate>
+    void replay_in_child(const char *name, const trace &t)
+    {
+        std::fflush(stdout);
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            replay<Candidate>(name, t);
+            std::fflush(stdout);
+            _exit(0);
+        }
+        int status = 0;
+        waitpid(pid, &status, 0);
+    }
+
+    void print_summary(const trace &t)
+    {
+        std::map<uint16_t, std::pair<size_t, size_t>> by_type; // 次数，字节数
+        for (const record &r : t.ops)
+        {
+            if (r.op != record::allocate)
+                continue;
+            auto &s = by_type[r.type];
+            ++s.first;
+            s.second += r.size;
+        }
+        std::printf("%zu records, %zu types\n", t.ops.size(), t.types.size());
+        for (const auto &kv : by_type)
+        {
+            const char *type = kv.first < t.types.size() ? t.types[kv.first].c_str() : "?";
+            std::printf("  %-40s %10zu allocations %12zu bytes\n", type, kv.second.first, kv.second.second);
+        }
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: %s <trace> [malloc|new|pool|thread_cache|remote_free|monotonic ...]\n",
+                     argv[0]);
+        return 1;
+    }
+    trace t;
+    if (!load_trace(argv[1], t))
+    {
+        std::fprintf(stderr, "cannot read trace %s\n", argv[1]);
+        return 1;
+    }
+    print_summary(t);
+#if defined(__GLIBC__)
+    // 读轨迹与配对时释放的内存还给系统，子进程的基线里不再有可以直接复用的空闲页
+    malloc_trim(0);
+#endif
+
+    std::vector<std::string> names;
+    for (int i = 2; i < argc; ++i)
+        names.push_back(argv[i]);
+    if (names.empty())
+        names = {"malloc", "new", "pool", "thread_cache", "remote_free", "monotonic"};
+    for (const auto &name : names)
+    {
+        if (name == "malloc")
+            replay_in_child<malloc_candidate>("malloc", t);
+        else if (name == "new")
+            replay_in_child<new_candidate>("new", t);
+        else if (name == "pool")
+            replay_in_child<static_candidate<mystl::pool_alloc>>("pool", t);
+        else if (name == "thread_cache")
+            replay_in_child<static_candidate<mystl::thread_cache_alloc>>("thread_cache", t);
+        else if (name == "remote_free")
+            replay_in_child<static_candidate<mystl::remote_free_alloc>>("remote_free", t);
+        else if (name == "monotonic")
+            replay_in_child<monotonic_candidate>("monotonic", t);
+        else
+            std::fprintf(stderr, "unknown allocator %s\n", name.c_str());
+    }
+    return 0;
+}